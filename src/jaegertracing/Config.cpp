@@ -23,6 +23,9 @@ namespace jaegertracing {
 constexpr const char* Config::kJAEGER_SERVICE_NAME_ENV_PROP;
 constexpr const char* Config::kJAEGER_TAGS_ENV_PROP;
 constexpr const char* Config::kJAEGER_JAEGER_DISABLED_ENV_PROP;
+constexpr const char* Config::kJAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS_ENV_PROP;
+constexpr const char* Config::kJAEGER_SINGLE_OWNER_SPANS_ENV_PROP;
+constexpr const char* Config::kJAEGER_DETACH_FINISHED_SPANS_ENV_PROP;
 
 void Config::fromEnv()
 {
@@ -44,6 +47,24 @@ void Config::fromEnv()
         _propagationFormat = parsePropagationFormat(propagationFormat);
     }
 
+    const auto lightweightUnsampledSpans = utils::EnvVariable::getBoolVariable(
+        kJAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS_ENV_PROP);
+    if (lightweightUnsampledSpans.first) {
+        _lightweightUnsampledSpans = lightweightUnsampledSpans.second;
+    }
+
+    const auto singleOwnerSpans = utils::EnvVariable::getBoolVariable(
+        kJAEGER_SINGLE_OWNER_SPANS_ENV_PROP);
+    if (singleOwnerSpans.first) {
+        _singleOwnerSpans = singleOwnerSpans.second;
+    }
+
+    const auto detachFinishedSpans = utils::EnvVariable::getBoolVariable(
+        kJAEGER_DETACH_FINISHED_SPANS_ENV_PROP);
+    if (detachFinishedSpans.first) {
+        _detachFinishedSpans = detachFinishedSpans.second;
+    }
+
     const auto serviceName =
         utils::EnvVariable::getStringVariable(kJAEGER_SERVICE_NAME_ENV_PROP);
     if (!serviceName.empty()) {
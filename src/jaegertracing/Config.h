@@ -37,6 +37,12 @@ class Config {
     static constexpr auto kJAEGER_JAEGER_DISABLED_ENV_PROP = "JAEGER_DISABLED";
     static constexpr auto kJAEGER_JAEGER_TRACEID_128BIT_ENV_PROP = "JAEGER_TRACEID_128BIT";
     static constexpr auto kJAEGER_PROPAGATION_ENV_PROP = "JAEGER_PROPAGATION";
+    static constexpr auto kJAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS_ENV_PROP =
+        "JAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS";
+    static constexpr auto kJAEGER_SINGLE_OWNER_SPANS_ENV_PROP =
+        "JAEGER_SINGLE_OWNER_SPANS";
+    static constexpr auto kJAEGER_DETACH_FINISHED_SPANS_ENV_PROP =
+        "JAEGER_DETACH_FINISHED_SPANS";
 
 #ifdef JAEGERTRACING_WITH_YAML_CPP
 
@@ -59,6 +65,16 @@ class Config {
             parsePropagationFormat(utils::yaml::findOrDefault<std::string>(
                 configYAML, "propagation_format", "jaeger"));
 
+        const auto lightweightUnsampledSpans =
+            utils::yaml::findOrDefault<bool>(
+                configYAML, "lightweight_unsampled_spans", false);
+
+        const auto singleOwnerSpans = utils::yaml::findOrDefault<bool>(
+            configYAML, "single_owner_spans", false);
+
+        const auto detachFinishedSpans = utils::yaml::findOrDefault<bool>(
+            configYAML, "detach_finished_spans", false);
+
         const auto samplerNode = configYAML["sampler"];
         const auto sampler = samplers::Config::parse(samplerNode);
         const auto reporterNode = configYAML["reporter"];
@@ -83,7 +99,10 @@ class Config {
                       baggageRestrictions,
                       serviceName,
                       tags,
-                      propagationFormat);
+                      propagationFormat,
+                      lightweightUnsampledSpans,
+                      singleOwnerSpans,
+                      detachFinishedSpans);
     }
 
 #endif  // JAEGERTRACING_WITH_YAML_CPP
@@ -99,10 +118,16 @@ class Config {
                     const std::string& serviceName = "",
                     const std::vector<Tag>&  tags = std::vector<Tag>(),
                     const propagation::Format propagationFormat =
-                        propagation::Format::JAEGER)
+                        propagation::Format::JAEGER,
+                    bool lightweightUnsampledSpans = false,
+                    bool singleOwnerSpans = false,
+                    bool detachFinishedSpans = false)
         : _disabled(disabled)
         , _traceId128Bit(traceId128Bit)
         , _propagationFormat(propagationFormat)
+        , _lightweightUnsampledSpans(lightweightUnsampledSpans)
+        , _singleOwnerSpans(singleOwnerSpans)
+        , _detachFinishedSpans(detachFinishedSpans)
         , _serviceName(serviceName)
         , _tags(tags)
         , _sampler(sampler)
@@ -118,6 +143,23 @@ class Config {
 
     propagation::Format propagationFormat() const { return _propagationFormat; }
 
+    // Whether spans of unsampled traces are started as UnsampledSpan, which
+    // records nothing until a sampling.priority tag promotes it. Code that
+    // casts the spans it is given to jaegertracing::Span must not set this.
+    bool lightweightUnsampledSpans() const
+    {
+        return _lightweightUnsampledSpans;
+    }
+
+    // Whether spans take no locks. Each span must then only be used by the
+    // thread that started it; debug builds assert this.
+    bool singleOwnerSpans() const { return _singleOwnerSpans; }
+
+    // Whether a sampled span hands its tags, logs and references over to the
+    // reporter when finished rather than having them copied, after which
+    // the span no longer returns them.
+    bool detachFinishedSpans() const { return _detachFinishedSpans; }
+
     const samplers::Config& sampler() const { return _sampler; }
 
     const reporters::Config& reporter() const { return _reporter; }
@@ -142,6 +184,9 @@ class Config {
     bool _disabled;
     bool _traceId128Bit;
     propagation::Format _propagationFormat;
+    bool _lightweightUnsampledSpans;
+    bool _singleOwnerSpans;
+    bool _detachFinishedSpans;
     std::string _serviceName;
     std::vector< Tag > _tags;
     samplers::Config _sampler;
@@ -107,6 +107,36 @@ propagation_format: w3c
     }
 }
 
+TEST(Config, testLightweightUnsampledSpans)
+{
+    ASSERT_FALSE(Config().lightweightUnsampledSpans());
+    constexpr auto kConfigYAML = R"cfg(
+lightweight_unsampled_spans: true
+)cfg";
+    const auto config = Config::parse(YAML::Load(kConfigYAML));
+    ASSERT_TRUE(config.lightweightUnsampledSpans());
+}
+
+TEST(Config, testSingleOwnerSpans)
+{
+    ASSERT_FALSE(Config().singleOwnerSpans());
+    constexpr auto kConfigYAML = R"cfg(
+single_owner_spans: true
+)cfg";
+    const auto config = Config::parse(YAML::Load(kConfigYAML));
+    ASSERT_TRUE(config.singleOwnerSpans());
+}
+
+TEST(Config, testDetachFinishedSpans)
+{
+    ASSERT_FALSE(Config().detachFinishedSpans());
+    constexpr auto kConfigYAML = R"cfg(
+detach_finished_spans: true
+)cfg";
+    const auto config = Config::parse(YAML::Load(kConfigYAML));
+    ASSERT_TRUE(config.detachFinishedSpans());
+}
+
 TEST(Config, testTags)
 {
     {
@@ -165,8 +195,25 @@ TEST(Config, testFromEnv)
     testutils::EnvVariable::setEnv("JAEGER_ENDPOINT", "http://host34:56567");
 
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE", "33");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES", "65536");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_OVERFLOW_POLICY", "block");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_BLOCK_TIMEOUT", "75");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_PRIORITY_QUEUE_SIZE", "8");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SERIALIZER_THREADS", "2");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SENDER_THREADS", "4");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_RETRY_BUFFER_SIZE", "131072");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_UDP_PACKETS_PER_SEND", "16");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_MAX_IN_FLIGHT", "3");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_COMPRESSION", "zstd");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_COMPRESSION_LEVEL", "5");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_CHUNK_SIZE", "32768");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_MAX_BATCH_SIZE", "8388608");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SHARED_MEMORY_RING_SIZE", "33554432");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_IO_BACKEND", "io_uring");
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_FLUSH_INTERVAL", "45");
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_LOG_SPANS", "true");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_THREAD_BUFFER_SIZE", "16");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_THREAD_BUFFER_MAX_AGE", "20");
 
     testutils::EnvVariable::setEnv("JAEGER_SAMPLER_TYPE", "remote");
     testutils::EnvVariable::setEnv("JAEGER_SAMPLER_PARAM", "0.33");
@@ -176,6 +223,9 @@ TEST(Config, testFromEnv)
     testutils::EnvVariable::setEnv("JAEGER_TAGS", "hostname=foobar,my.app.version=4.5.6");
 
     testutils::EnvVariable::setEnv("JAEGER_TRACEID_128BIT", "true");
+    testutils::EnvVariable::setEnv("JAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS", "true");
+    testutils::EnvVariable::setEnv("JAEGER_SINGLE_OWNER_SPANS", "true");
+    testutils::EnvVariable::setEnv("JAEGER_DETACH_FINISHED_SPANS", "true");
 
     config.fromEnv();
 
@@ -183,9 +233,37 @@ TEST(Config, testFromEnv)
     ASSERT_EQ(std::string("host33:45"), config.reporter().localAgentHostPort());
 
     ASSERT_EQ(33, config.reporter().queueSize());
+    ASSERT_EQ(65536u, config.reporter().queueSizeBytes());
+    ASSERT_EQ(reporters::OverflowPolicy::kBlock,
+              config.reporter().overflowPolicy());
+    ASSERT_EQ(std::chrono::milliseconds(75), config.reporter().blockTimeout());
+    ASSERT_EQ(8, config.reporter().priorityQueueSize());
+    ASSERT_EQ(2, config.reporter().serializerThreads());
+    ASSERT_EQ(4, config.reporter().senderThreads());
+    ASSERT_EQ(131072, config.reporter().retryBufferSize());
+    ASSERT_EQ(16, config.reporter().udpPacketsPerSend());
+    ASSERT_EQ(3, config.reporter().httpMaxInFlight());
+    ASSERT_EQ(utils::Compressor::available(utils::Compression::kZstd)
+                  ? utils::Compression::kZstd
+                  : utils::Compression::kNone,
+              config.reporter().compression());
+    ASSERT_EQ(5, config.reporter().compressionLevel());
+    ASSERT_EQ(32768, config.reporter().httpChunkSize());
+    ASSERT_EQ(8388608, config.reporter().httpMaxBatchSize());
+    ASSERT_EQ(33554432u, config.reporter().sharedMemoryRingSize());
+#ifdef __linux__
+    ASSERT_EQ(utils::IOUring::available() ? utils::IOBackend::kIOUring
+                                          : utils::IOBackend::kSockets,
+              config.reporter().ioBackend());
+#else
+    ASSERT_EQ(utils::IOBackend::kSockets, config.reporter().ioBackend());
+#endif
     ASSERT_EQ(std::chrono::milliseconds(45),
               config.reporter().bufferFlushInterval());
     ASSERT_EQ(true, config.reporter().logSpans());
+    ASSERT_EQ(16, config.reporter().threadBufferSize());
+    ASSERT_EQ(std::chrono::milliseconds(20),
+              config.reporter().threadBufferMaxAge());
 
     ASSERT_EQ(std::string("remote"), config.sampler().type());
     ASSERT_EQ(0.33, config.sampler().param());
@@ -203,6 +281,9 @@ TEST(Config, testFromEnv)
     ASSERT_EQ(false, config.disabled());
 
     ASSERT_EQ(true, config.traceId128Bit());
+    ASSERT_EQ(true, config.lightweightUnsampledSpans());
+    ASSERT_EQ(true, config.singleOwnerSpans());
+    ASSERT_EQ(true, config.detachFinishedSpans());
 
     testutils::EnvVariable::setEnv("JAEGER_DISABLED", "TRue");  // case-insensitive
     testutils::EnvVariable::setEnv("JAEGER_AGENT_PORT", "445");
@@ -217,12 +298,65 @@ TEST(Config, testFromEnv)
     config.fromEnv();
     ASSERT_EQ(propagation::Format::W3C, config.propagationFormat());
 
+#ifndef WIN32
+    // The port does not apply to a socket or file on this host.
+    testutils::EnvVariable::setEnv("JAEGER_AGENT_HOST",
+                                   "unix:///var/run/jaeger-agent.sock");
+
+    config.fromEnv();
+    ASSERT_EQ(std::string("unix:///var/run/jaeger-agent.sock"),
+              config.reporter().localAgentHostPort());
+
+    testutils::EnvVariable::setEnv("JAEGER_AGENT_HOST",
+                                   "shm:///dev/shm/jaeger-spans");
+
+    config.fromEnv();
+    ASSERT_EQ(std::string("shm:///dev/shm/jaeger-spans"),
+              config.reporter().localAgentHostPort());
+#endif
+
+    // Byte counts do not have to fit in an int; negative ones are ignored.
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES",
+                                   "3221225472");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SHARED_MEMORY_RING_SIZE",
+                                   "3221225472");
+
+    config.fromEnv();
+    ASSERT_EQ(3221225472u, config.reporter().queueSizeBytes());
+    ASSERT_EQ(3221225472u, config.reporter().sharedMemoryRingSize());
+
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES",
+                                   "-1");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SHARED_MEMORY_RING_SIZE",
+                                   "-4096");
+
+    config.fromEnv();
+    ASSERT_EQ(3221225472u, config.reporter().queueSizeBytes());
+    ASSERT_EQ(3221225472u, config.reporter().sharedMemoryRingSize());
+
     testutils::EnvVariable::setEnv("JAEGER_AGENT_HOST", "");
     testutils::EnvVariable::setEnv("JAEGER_AGENT_PORT", "");
     testutils::EnvVariable::setEnv("JAEGER_ENDPOINT", "");
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_OVERFLOW_POLICY", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_BLOCK_TIMEOUT", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_PRIORITY_QUEUE_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SERIALIZER_THREADS", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SENDER_THREADS", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_RETRY_BUFFER_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_UDP_PACKETS_PER_SEND", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_MAX_IN_FLIGHT", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_COMPRESSION", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_COMPRESSION_LEVEL", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_CHUNK_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_HTTP_MAX_BATCH_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_SHARED_MEMORY_RING_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_IO_BACKEND", "");
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_FLUSH_INTERVAL", "");
     testutils::EnvVariable::setEnv("JAEGER_REPORTER_LOG_SPANS", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_THREAD_BUFFER_SIZE", "");
+    testutils::EnvVariable::setEnv("JAEGER_REPORTER_THREAD_BUFFER_MAX_AGE", "");
     testutils::EnvVariable::setEnv("JAEGER_SAMPLER_PARAM", "");
     testutils::EnvVariable::setEnv("JAEGER_SAMPLER_TYPE", "");
     testutils::EnvVariable::setEnv("JAEGER_SERVICE_NAME", "");
@@ -230,6 +364,9 @@ TEST(Config, testFromEnv)
     testutils::EnvVariable::setEnv("JAEGER_DISABLED", "");
     testutils::EnvVariable::setEnv("JAEGER_TRACE_ID_128BIT", "");
     testutils::EnvVariable::setEnv("JAEGER_PROPAGATION", "");
+    testutils::EnvVariable::setEnv("JAEGER_LIGHTWEIGHT_UNSAMPLED_SPANS", "");
+    testutils::EnvVariable::setEnv("JAEGER_SINGLE_OWNER_SPANS", "");
+    testutils::EnvVariable::setEnv("JAEGER_DETACH_FINISHED_SPANS", "");
 }
 
 }  // namespace jaegertracing
@@ -16,6 +16,7 @@
 
 #include "jaegertracing/LogRecord.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/CompactWriter.h"
 
 namespace jaegertracing {
 void LogRecord::thrift(thrift::Log& log) const
@@ -36,4 +37,30 @@ void LogRecord::thrift(thrift::Log& log) const
                    });
     log.__set_fields(fields);
 }
+
+void LogRecord::encode(utils::CompactWriter& writer) const
+{
+    using Type = utils::CompactWriter::Type;
+
+    const auto lastFieldId = writer.writeStructBegin();
+    writer.writeI64Field(1,
+                         std::chrono::duration_cast<std::chrono::microseconds>(
+                             _timestamp.time_since_epoch())
+                             .count());
+    writer.writeListField(
+        2, Type::kStruct, static_cast<uint32_t>(_fields.size()));
+    for (auto&& field : _fields) {
+        field.encode(writer);
+    }
+    writer.writeStructEnd(lastFieldId);
+}
+
+size_t LogRecord::estimatedSize() const
+{
+    auto size = sizeof(LogRecord);
+    for (auto&& field : _fields) {
+        size += field.estimatedSize();
+    }
+    return size;
+}
 }  // namespace jaegertracing
@@ -18,7 +18,9 @@
 #define JAEGERTRACING_LOGRECORD_H
 
 #include "jaegertracing/Compilers.h"
+#include "jaegertracing/Constants.h"
 #include "jaegertracing/Tag.h"
+#include "jaegertracing/utils/SmallVector.h"
 #include <algorithm>
 #include <chrono>
 #include <iterator>
@@ -31,10 +33,15 @@ namespace jaegertracing {
 namespace thrift {
 class Log;
 }
+namespace utils {
+class Arena;
+class CompactWriter;
+}
 
 class LogRecord {
   public:
     using Clock = std::chrono::system_clock;
+    using Fields = utils::SmallVector<Tag, kLogInlineFields>;
 
     LogRecord()
         : _timestamp(Clock::now())
@@ -50,21 +57,52 @@ class LogRecord {
     {
     }
 
+    LogRecord(const Clock::time_point& timestamp, Fields&& fields)
+        : _timestamp(timestamp)
+        , _fields(std::move(fields))
+    {
+    }
+
     LogRecord(const opentracing::LogRecord& other)
         : _timestamp(other.timestamp)
         , _fields(other.fields.begin(), other.fields.end())
     {
     }
 
+    // Copies the strings of the fields into `arena`, see Tag.
+    LogRecord(const opentracing::LogRecord& other, utils::Arena& arena)
+        : _timestamp(other.timestamp)
+        , _fields()
+    {
+        _fields.reserve(other.fields.size());
+        for (auto&& field : other.fields) {
+            _fields.emplace_back(field.first, field.second, arena);
+        }
+    }
+
+    LogRecord(const LogRecord& other, utils::Arena& arena)
+        : _timestamp(other._timestamp)
+        , _fields()
+    {
+        _fields.reserve(other._fields.size());
+        for (auto&& field : other._fields) {
+            _fields.emplace_back(field.key(), field.value(), arena);
+        }
+    }
+
     const Clock::time_point& timestamp() const { return _timestamp; }
 
-    const std::vector<Tag>& fields() const { return _fields; }
+    const Fields& fields() const { return _fields; }
 
     void thrift(thrift::Log& log) const;
 
+    void encode(utils::CompactWriter& writer) const;
+
+    size_t estimatedSize() const;
+
   private:
     Clock::time_point _timestamp;
-    std::vector<Tag> _fields;
+    Fields _fields;
 };
 
 }  // namespace jaegertracing
@@ -16,6 +16,7 @@
 
 #include "jaegertracing/Reference.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/CompactWriter.h"
 
 namespace jaegertracing {
 void Reference::thrift(thrift::SpanRef& spanRef) const
@@ -38,4 +39,27 @@ void Reference::thrift(thrift::SpanRef& spanRef) const
     spanRef.__set_traceIdLow(_spanContext.traceID().low());
     spanRef.__set_spanId(_spanContext.spanID());
 }
+
+void Reference::encode(utils::CompactWriter& writer) const
+{
+    const auto lastFieldId = writer.writeStructBegin();
+    switch (_type) {
+    case Type::ChildOfRef: {
+        writer.writeI32Field(1, thrift::SpanRefType::CHILD_OF);
+    } break;
+    case Type::FollowsFromRef: {
+        writer.writeI32Field(1, thrift::SpanRefType::FOLLOWS_FROM);
+    } break;
+    default: {
+        std::ostringstream oss;
+        oss << "Invalid span reference type " << static_cast<int>(_type)
+            << ", context " << _spanContext;
+        throw std::invalid_argument(oss.str());
+    } break;
+    }
+    writer.writeI64Field(2, _spanContext.traceID().low());
+    writer.writeI64Field(3, _spanContext.traceID().high());
+    writer.writeI64Field(4, _spanContext.spanID());
+    writer.writeStructEnd(lastFieldId);
+}
 }  // namespace jaegertracing
@@ -29,6 +29,9 @@ namespace jaegertracing {
 namespace thrift {
 class SpanRef;
 }
+namespace utils {
+class CompactWriter;
+}
 
 class Reference {
   public:
@@ -46,6 +49,8 @@ class Reference {
 
     void thrift(thrift::SpanRef& spanRef) const;
 
+    void encode(utils::CompactWriter& writer) const;
+
   private:
     SpanContext _spanContext;
     Type _type;
@@ -15,3 +15,37 @@
  */
 
 #include "jaegertracing/Sender.h"
+
+#include "jaegertracing/Span.h"
+
+namespace jaegertracing {
+namespace {
+
+class UnserializedSpan : public Sender::SerializedSpan {
+  public:
+    explicit UnserializedSpan(std::unique_ptr<Span>&& span)
+        : _span(std::move(span))
+    {
+    }
+
+    const Span& span() const { return *_span; }
+
+  private:
+    std::unique_ptr<Span> _span;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<Sender::SerializedSpan>
+Sender::serialize(std::unique_ptr<Span>&& span) const
+{
+    return std::unique_ptr<SerializedSpan>(
+        new UnserializedSpan(std::move(span)));
+}
+
+int Sender::appendSerialized(std::unique_ptr<SerializedSpan>&& span)
+{
+    return append(static_cast<const UnserializedSpan&>(*span).span());
+}
+
+}  // namespace jaegertracing
@@ -17,6 +17,7 @@
 #ifndef JAEGERTRACING_SENDER_H
 #define JAEGERTRACING_SENDER_H
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -30,22 +31,43 @@ class Sender {
   public:
     class Exception : public std::runtime_error {
       public:
-        Exception(const std::string& what, int numFailed)
+        Exception(const std::string& what, int numFailed, int numSent = 0)
             : std::runtime_error(what)
             , _numFailed(numFailed)
+            , _numSent(numSent)
         {
         }
 
         int numFailed() const { return _numFailed; }
 
+        // Spans sent by the same call before the failure.
+        int numSent() const { return _numSent; }
+
       private:
         int _numFailed;
+        int _numSent;
+    };
+
+    // A span in the form a sender appends it, produced by serialize().
+    class SerializedSpan {
+      public:
+        virtual ~SerializedSpan() = default;
     };
 
     virtual ~Sender() = default;
 
     virtual int append(const Span& span) = 0;
 
+    // Splits append() in two so that the conversion of a span to its wire
+    // format can run on other threads than batching and sending it.
+    // serialize() must be safe to call concurrently with any other member.
+    // The default keeps the span as is for append(const Span&).
+    virtual std::unique_ptr<SerializedSpan>
+    serialize(std::unique_ptr<Span>&& span) const;
+
+    // Takes a span from serialize() of a sender of the same type.
+    virtual int appendSerialized(std::unique_ptr<SerializedSpan>&& span);
+
     virtual int flush() = 0;
 
     virtual void close() = 0;
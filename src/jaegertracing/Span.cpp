@@ -15,9 +15,11 @@
  */
 
 #include "jaegertracing/Span.h"
+#include "jaegertracing/SpanPool.h"
 #include "jaegertracing/Tracer.h"
 #include "jaegertracing/baggage/BaggageSetter.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/CompactWriter.h"
 #include <cassert>
 #include <cstdint>
 #include <istream>
@@ -67,7 +69,7 @@ struct SamplingPriorityVisitor {
 void Span::SetBaggageItem(opentracing::string_view restrictedKey,
                           opentracing::string_view value) noexcept
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<Mutex> lock(_mutex);
     const auto& baggageSetter = _tracer->baggageSetter();
     auto baggage = _context.baggage();
     baggageSetter.setBaggage(*this,
@@ -81,6 +83,19 @@ void Span::SetBaggageItem(opentracing::string_view restrictedKey,
     _context = _context.withBaggage(baggage);
 }
 
+Span::~Span()
+{
+    Finish();
+    if (_tracer) {
+        SpanPool::Buffers buffers;
+        buffers._tags.swap(_tags);
+        buffers._logs.swap(_logs);
+        buffers._references.swap(_references);
+        buffers._arena.swap(_arena);
+        _tracer->spanPool().release(std::move(buffers));
+    }
+}
+
 void Span::FinishWithOptions(
     const opentracing::FinishSpanOptions& finishSpanOptions) noexcept
 {
@@ -89,9 +104,10 @@ void Span::FinishWithOptions(
             ? SteadyClock::now()
             : finishSpanOptions.finish_steady_timestamp;
     std::shared_ptr<const Tracer> tracer;
+    std::unique_ptr<Span> finished;
     {
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         if (isFinished()) {
             // Already finished, so return immediately.
             return;
@@ -105,20 +121,71 @@ void Span::FinishWithOptions(
 
         tracer = _tracer;
 
-        std::copy(finishSpanOptions.log_records.begin(),
-                  finishSpanOptions.log_records.end(),
-                  std::back_inserter(_logs));
+        for (auto&& record : finishSpanOptions.log_records) {
+            _logs.emplace_back(record, _arena);
+        }
+
+        if (tracer && _context.isSampled() && tracer->detachFinishedSpans()) {
+            finished = detachNoLock();
+        }
     }
 
     // Call `reportSpan` even for non-sampled traces.
-    if (tracer) {
+    if (!tracer) {
+        return;
+    }
+    if (tracer->detachFinishedSpans()) {
+        tracer->reportSpan(std::move(finished));
+    }
+    else {
         tracer->reportSpan(*this);
     }
 }
 
+std::unique_ptr<Span> Span::detachNoLock()
+{
+    // Move the recorded data into the span handed to the reporter rather
+    // than copying it. Baggage is not reported, so it stays behind with this
+    // span's context.
+    std::unique_ptr<Span> span(new Span(_tracer,
+                                        SpanContext(_context.traceID(),
+                                                    _context.spanID(),
+                                                    _context.parentID(),
+                                                    _context.flags(),
+                                                    SpanContext::StrMap(),
+                                                    _context.debugID(),
+                                                    _context.traceState()),
+                                        _operationName,
+                                        _startTimeSystem,
+                                        _startTimeSteady));
+    span->_duration = _duration;
+    span->_tags.swap(_tags);
+    span->_logs.swap(_logs);
+    span->_references.swap(_references);
+    span->_arena.swap(_arena);
+    return span;
+}
+
+size_t Span::estimatedSize() const
+{
+    std::lock_guard<Mutex> lock(_mutex);
+    auto size = sizeof(Span) + _operationName.size() +
+                _references.size() * sizeof(Reference) + _arena.capacity();
+    for (auto&& item : _context.baggage()) {
+        size += item.first.size() + item.second.size();
+    }
+    for (auto&& tag : _tags) {
+        size += tag.estimatedSize();
+    }
+    for (auto&& log : _logs) {
+        size += log.estimatedSize();
+    }
+    return size;
+}
+
 const opentracing::Tracer& Span::tracer() const noexcept
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<Mutex> lock(_mutex);
     if (_tracer) {
         return *_tracer;
     }
@@ -129,7 +196,7 @@ const opentracing::Tracer& Span::tracer() const noexcept
 
 std::string Span::serviceName() const noexcept
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<Mutex> lock(_mutex);
     return serviceNameNoLock();
 }
 
@@ -141,12 +208,17 @@ std::string Span::serviceNameNoLock() const noexcept
     return _tracer->serviceName();
 }
 
-void Span::setSamplingPriority(const opentracing::Value& value)
+bool Span::samplingPriority(const opentracing::Value& value)
 {
     SamplingPriorityVisitor visitor;
-    const auto priority = opentracing::Value::visit(value, visitor);
+    return opentracing::Value::visit(value, visitor);
+}
+
+void Span::setSamplingPriority(const opentracing::Value& value)
+{
+    const auto priority = samplingPriority(value);
 
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<Mutex> lock(_mutex);
     auto newFlags = _context.flags();
     if (priority) {
         newFlags |= static_cast<unsigned char>(SpanContext::Flag::kSampled) |
@@ -166,7 +238,7 @@ void Span::setSamplingPriority(const opentracing::Value& value)
 
 void Span::thrift(thrift::Span& span) const
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    std::lock_guard<Mutex> lock(_mutex);
     span.__set_traceIdHigh(_context.traceID().high());
     span.__set_traceIdLow(_context.traceID().low());
     span.__set_spanId(_context.spanID());
@@ -218,4 +290,46 @@ void Span::thrift(thrift::Span& span) const
     span.__set_logs(logs);
 }
 
+void Span::encode(utils::CompactWriter& writer) const
+{
+    using Type = utils::CompactWriter::Type;
+
+    std::lock_guard<Mutex> lock(_mutex);
+    const auto lastFieldId = writer.writeStructBegin();
+    writer.writeI64Field(1, _context.traceID().low());
+    writer.writeI64Field(2, _context.traceID().high());
+    writer.writeI64Field(3, _context.spanID());
+    writer.writeI64Field(4, _context.parentID());
+    writer.writeStringField(5, _operationName);
+
+    writer.writeListField(
+        6, Type::kStruct, static_cast<uint32_t>(_references.size()));
+    for (auto&& ref : _references) {
+        ref.encode(writer);
+    }
+
+    writer.writeI32Field(7, _context.flags());
+    writer.writeI64Field(8,
+                         std::chrono::duration_cast<std::chrono::microseconds>(
+                             _startTimeSystem.time_since_epoch())
+                             .count());
+    writer.writeI64Field(
+        9,
+        std::chrono::duration_cast<std::chrono::microseconds>(_duration)
+            .count());
+
+    writer.writeListField(
+        10, Type::kStruct, static_cast<uint32_t>(_tags.size()));
+    for (auto&& tag : _tags) {
+        tag.encode(writer);
+    }
+
+    writer.writeListField(
+        11, Type::kStruct, static_cast<uint32_t>(_logs.size()));
+    for (auto&& log : _logs) {
+        log.encode(writer);
+    }
+    writer.writeStructEnd(lastFieldId);
+}
+
 }  // namespace jaegertracing
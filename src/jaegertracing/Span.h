@@ -25,8 +25,12 @@
 
 #include "jaegertracing/LogRecord.h"
 #include "jaegertracing/Reference.h"
+#include "jaegertracing/Constants.h"
 #include "jaegertracing/SpanContext.h"
 #include "jaegertracing/Tag.h"
+#include "jaegertracing/utils/Arena.h"
+#include "jaegertracing/utils/OptionalMutex.h"
+#include "jaegertracing/utils/SmallVector.h"
 
 namespace jaegertracing {
 
@@ -35,11 +39,17 @@ class Tracer;
 namespace thrift {
 class Span;
 }
+namespace utils {
+class CompactWriter;
+}
 
 class Span : public opentracing::Span {
   public:
     using SteadyClock = opentracing::SteadyClock;
     using SystemClock = opentracing::SystemClock;
+    using Tags = utils::SmallVector<Tag, kSpanInlineTags>;
+    using Logs = utils::SmallVector<LogRecord, kSpanInlineLogs>;
+    using References = utils::SmallVector<Reference, kSpanInlineReferences>;
 
     explicit Span(
         const std::shared_ptr<const Tracer>& tracer = nullptr,
@@ -55,16 +65,44 @@ class Span : public opentracing::Span {
         , _startTimeSystem(startTimeSystem)
         , _startTimeSteady(startTimeSteady)
         , _duration()
-        , _tags(tags)
-        , _references(references)
+        , _tags(std::begin(tags), std::end(tags))
+        , _references(std::begin(references), std::end(references))
+    {
+    }
+
+    // Takes over the storage of `tags`, `logs`, `references` and `arena`,
+    // which already hold the span's initial tags and references. A
+    // `singleOwner` span takes no locks and must only be used by the thread
+    // that started it, which debug builds assert.
+    Span(const std::shared_ptr<const Tracer>& tracer,
+         const SpanContext& context,
+         const std::string& operationName,
+         const SystemClock::time_point& startTimeSystem,
+         const SteadyClock::time_point& startTimeSteady,
+         Tags&& tags,
+         Logs&& logs,
+         References&& references,
+         utils::Arena&& arena,
+         bool singleOwner)
+        : _tracer(tracer)
+        , _context(context)
+        , _operationName(operationName)
+        , _startTimeSystem(startTimeSystem)
+        , _startTimeSteady(startTimeSteady)
+        , _duration()
+        , _tags(std::move(tags))
+        , _logs(std::move(logs))
+        , _references(std::move(references))
+        , _arena(std::move(arena))
+        , _mutex(!singleOwner)
     {
     }
 
     Span(const Span& span)
     {
         std::lock(_mutex, span._mutex);
-        std::lock_guard<std::mutex> lock(_mutex, std::adopt_lock);
-        std::lock_guard<std::mutex> spanLock(span._mutex, std::adopt_lock);
+        std::lock_guard<Mutex> lock(_mutex, std::adopt_lock);
+        std::lock_guard<Mutex> spanLock(span._mutex, std::adopt_lock);
 
         _tracer = span._tracer;
         _context = span._context;
@@ -72,8 +110,15 @@ class Span : public opentracing::Span {
         _startTimeSystem = span._startTimeSystem;
         _startTimeSteady = span._startTimeSteady;
         _duration = span._duration;
-        _tags = span._tags;
-        _logs = span._logs;
+        // The copies refer to this span's arena, not to the other one.
+        _tags.reserve(span._tags.size());
+        for (auto&& tag : span._tags) {
+            _tags.emplace_back(tag.key(), tag.value(), _arena);
+        }
+        _logs.reserve(span._logs.size());
+        for (auto&& log : span._logs) {
+            _logs.emplace_back(log, _arena);
+        }
         _references = span._references;
     }
 
@@ -84,15 +129,16 @@ class Span : public opentracing::Span {
         return *this;
     }
 
-    ~Span() { Finish(); }
+    // Hands the span's vectors back to the tracer's pool.
+    ~Span();
 
     void swap(Span& span)
     {
         using std::swap;
 
         std::lock(_mutex, span._mutex);
-        std::lock_guard<std::mutex> lock(_mutex, std::adopt_lock);
-        std::lock_guard<std::mutex> spanLock(span._mutex, std::adopt_lock);
+        std::lock_guard<Mutex> lock(_mutex, std::adopt_lock);
+        std::lock_guard<Mutex> spanLock(span._mutex, std::adopt_lock);
 
         swap(_tracer, span._tracer);
         swap(_context, span._context);
@@ -103,49 +149,70 @@ class Span : public opentracing::Span {
         swap(_tags, span._tags);
         swap(_logs, span._logs);
         swap(_references, span._references);
+        swap(_arena, span._arena);
     }
 
     friend void swap(Span& lhs, Span& rhs) { lhs.swap(rhs); }
 
     void thrift(thrift::Span& span) const;
 
+    // Writes what thrift::Span::write() would for the result of thrift() with
+    // a compact protocol, without building the thrift::Span.
+    void encode(utils::CompactWriter& writer) const;
+
     template <typename Stream>
     void print(Stream& out) const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         out << _context;
     }
 
     std::string operationName() const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         return _operationName;
     }
 
     SystemClock::time_point startTimeSystem() const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         return _startTimeSystem;
     }
 
     SteadyClock::time_point startTimeSteady() const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         return _startTimeSteady;
     }
 
     SteadyClock::duration duration() const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         return _duration;
     }
 
+    // With Tracer::kDetachFinishedSpansOption, a sampled span's tags, logs
+    // and references are handed over to the reporter once it is finished
+    // and no longer available here.
     std::vector<Tag> tags() const
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        return _tags;
+        std::lock_guard<Mutex> lock(_mutex);
+        std::vector<Tag> tags;
+        tags.reserve(_tags.size());
+        for (auto&& tag : _tags) {
+            tags.push_back(tag.owned());
+        }
+        return tags;
     }
 
+    // Approximate number of bytes retained by this span, used to bound the
+    // reporter queue by memory rather than span count.
+    size_t estimatedSize() const;
+
+    // Whether a sampling.priority tag of `value` asks for the trace to be
+    // sampled.
+    static bool samplingPriority(const opentracing::Value& value);
+
     template <typename... Arg>
     void setOperationName(Arg&&... args)
     {
@@ -157,7 +224,7 @@ class Span : public opentracing::Span {
 
     void SetOperationName(opentracing::string_view name) noexcept override
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         if (isFinished()) {
             return;
         }
@@ -171,11 +238,11 @@ class Span : public opentracing::Span {
             setSamplingPriority(value);
             return;
         }
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         if (isFinished() || !_context.isSampled()) {
             return;
         }
-        _tags.push_back(Tag(key, value));
+        _tags.emplace_back(key, value, _arena);
     }
 
     void SetBaggageItem(opentracing::string_view restrictedKey,
@@ -184,7 +251,7 @@ class Span : public opentracing::Span {
     std::string BaggageItem(opentracing::string_view restrictedKey) const
         noexcept override
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         auto itr = _context.baggage().find(restrictedKey);
         return (itr == std::end(_context.baggage())) ? std::string()
                                                      : itr->second;
@@ -215,12 +282,14 @@ class Span : public opentracing::Span {
 
     const SpanContext& context() const noexcept override
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         return _context;
     }
 
     const SpanContext& contextNoLock() const noexcept { return _context; }
 
+    bool singleOwner() const { return !_mutex.enabled(); }
+
     const opentracing::Tracer& tracer() const noexcept override;
 
     std::string serviceName() const noexcept;
@@ -228,32 +297,37 @@ class Span : public opentracing::Span {
     std::string serviceNameNoLock() const noexcept;
 
   private:
+    using Mutex = utils::OptionalMutex;
+
     bool isFinished() const { return _duration != SteadyClock::duration(); }
 
+    std::unique_ptr<Span> detachNoLock();
+
     template <typename FieldIterator>
     void logFieldsNoLocking(const std::chrono::system_clock::time_point& timestamp, FieldIterator first, FieldIterator last) noexcept
     {
-        LogRecord log(timestamp, first, last);
-        _logs.push_back(log);
+        _logs.emplace_back(timestamp, first, last);
     }
 
     template <typename Container>
     void doLog(opentracing::SystemTime timestamp, Container fieldPairs) noexcept
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<Mutex> lock(_mutex);
         if (!_context.isSampled()) {
             return;
         }
 
-        std::vector<Tag> fields;
+        LogRecord::Fields fields;
         fields.reserve(fieldPairs.size());
         std::transform(
             std::begin(fieldPairs),
             std::end(fieldPairs),
             std::back_inserter(fields),
-            [](const std::pair<opentracing::string_view, opentracing::Value>&
-                   pair) { return Tag(pair.first, pair.second); });
-        logFieldsNoLocking(timestamp, std::begin(fields), std::end(fields));
+            [this](const std::pair<opentracing::string_view,
+                                   opentracing::Value>& pair) {
+                return Tag(pair.first, pair.second, _arena);
+            });
+        _logs.emplace_back(timestamp, std::move(fields));
     }
 
     void setSamplingPriority(const opentracing::Value& value);
@@ -264,10 +338,12 @@ class Span : public opentracing::Span {
     SystemClock::time_point _startTimeSystem;
     SteadyClock::time_point _startTimeSteady;
     SteadyClock::duration _duration;
-    std::vector<Tag> _tags;
-    std::vector<LogRecord> _logs;
-    std::vector<Reference> _references;
-    mutable std::mutex _mutex;
+    Tags _tags;
+    Logs _logs;
+    References _references;
+    // Holds the strings of the tags and logs above.
+    utils::Arena _arena;
+    mutable Mutex _mutex;
 };
 
 }  // namespace jaegertracing
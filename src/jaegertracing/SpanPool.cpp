@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/SpanPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+#include "jaegertracing/metrics/Counter.h"
+#include "jaegertracing/metrics/Metrics.h"
+
+namespace jaegertracing {
+namespace {
+
+std::atomic<uint64_t> nextId(0);
+
+template <typename Container>
+void clear(Container& items)
+{
+    if (items.capacity() > SpanPool::kMaxCapacity) {
+        Container().swap(items);
+    }
+    else {
+        items.clear();
+    }
+}
+
+void clear(utils::Arena& arena)
+{
+    arena.reset();
+    if (arena.capacity() > utils::Arena::kMaxChunkSize) {
+        utils::Arena().swap(arena);
+    }
+}
+
+template <typename Container>
+bool allocated(const Container& items)
+{
+    return items.capacity() > Container::kInlineCapacity;
+}
+
+}  // anonymous namespace
+
+constexpr size_t SpanPool::kThreadCacheSize;
+constexpr size_t SpanPool::kSharedSize;
+constexpr size_t SpanPool::kMaxCapacity;
+
+// The freelists of one thread, at most one per SpanPool instance. Entries
+// are keyed by id rather than address since a pool may be destroyed and
+// another one allocated at the same address.
+class SpanPool::ThreadCaches {
+  public:
+    ~ThreadCaches()
+    {
+        for (auto&& entry : _entries) {
+            const auto shared = entry._shared.lock();
+            if (shared) {
+                spill(*shared, entry._buffers, entry._buffers.size());
+            }
+        }
+    }
+
+    std::vector<Buffers>& find(uint64_t id,
+                               const std::shared_ptr<Shared>& shared)
+    {
+        for (auto&& entry : _entries) {
+            if (entry._id == id) {
+                return entry._buffers;
+            }
+        }
+
+        _entries.erase(std::remove_if(_entries.begin(),
+                                      _entries.end(),
+                                      [](const Entry& entry) {
+                                          return entry._shared.expired();
+                                      }),
+                       _entries.end());
+
+        Entry entry;
+        entry._id = id;
+        entry._shared = shared;
+        entry._buffers.reserve(kThreadCacheSize);
+        _entries.push_back(std::move(entry));
+        return _entries.back()._buffers;
+    }
+
+  private:
+    struct Entry {
+        uint64_t _id;
+        std::weak_ptr<Shared> _shared;
+        std::vector<Buffers> _buffers;
+    };
+
+    std::vector<Entry> _entries;
+};
+
+SpanPool::SpanPool(metrics::Metrics& metrics)
+    : _metrics(metrics)
+    , _id(nextId++)
+    , _shared(std::make_shared<Shared>())
+{
+}
+
+SpanPool::Buffers SpanPool::acquire()
+{
+    auto& cache = threadCache();
+    if (cache.empty() && _shared->_size.load(std::memory_order_relaxed) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(_shared->_mutex);
+            auto& shared = _shared->_buffers;
+            const auto first =
+                shared.end() - std::min(shared.size(), kThreadCacheSize / 2);
+            std::move(first, shared.end(), std::back_inserter(cache));
+            shared.erase(first, shared.end());
+            _shared->_size.store(shared.size(), std::memory_order_relaxed);
+        }
+        // Other threads may have emptied the list since it was looked at.
+        if (!cache.empty()) {
+            _metrics.spanPoolRefills().inc(1);
+        }
+    }
+    if (cache.empty()) {
+        _metrics.spanPoolMisses().inc(1);
+        return Buffers();
+    }
+    _metrics.spanPoolHits().inc(1);
+    Buffers buffers(std::move(cache.back()));
+    cache.pop_back();
+    return buffers;
+}
+
+void SpanPool::release(Buffers&& buffers)
+{
+    clear(buffers._tags);
+    clear(buffers._logs);
+    clear(buffers._references);
+    clear(buffers._arena);
+    if (!allocated(buffers._tags) && !allocated(buffers._logs) &&
+        !allocated(buffers._references) && buffers._arena.capacity() == 0) {
+        // Nothing worth keeping, the span's data fit inline or went to the
+        // reporter.
+        return;
+    }
+
+    auto& cache = threadCache();
+    if (cache.size() >= kThreadCacheSize) {
+        spill(*_shared, cache, kThreadCacheSize / 2);
+    }
+    cache.push_back(std::move(buffers));
+}
+
+void SpanPool::spill(Shared& shared,
+                     std::vector<Buffers>& cache,
+                     size_t count)
+{
+    const auto first = cache.end() - count;
+    {
+        std::lock_guard<std::mutex> lock(shared._mutex);
+        const auto room =
+            kSharedSize - std::min(kSharedSize, shared._buffers.size());
+        std::move(first,
+                  first + std::min(count, room),
+                  std::back_inserter(shared._buffers));
+        shared._size.store(shared._buffers.size(), std::memory_order_relaxed);
+    }
+    // Whatever did not fit is freed.
+    cache.erase(first, cache.end());
+}
+
+std::vector<SpanPool::Buffers>& SpanPool::threadCache()
+{
+    static thread_local ThreadCaches threadCaches;
+    return threadCaches.find(_id, _shared);
+}
+
+}  // namespace jaegertracing
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_SPANPOOL_H
+#define JAEGERTRACING_SPANPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "jaegertracing/Span.h"
+#include "jaegertracing/utils/Arena.h"
+
+namespace jaegertracing {
+namespace metrics {
+class Metrics;
+}
+
+// Keeps the tag, log and reference vectors of destroyed spans that outgrew
+// their inline storage, and their string arenas, emptied but with their
+// capacity, for the spans the tracer starts next. Each thread
+// takes from and returns to its own freelist without locking. Sampled spans
+// are mostly destroyed on the reporter's threads, so a freelist that fills
+// up passes half of it to a shared list, which empty freelists refill from.
+// The shared list is only locked when it has something to give, so threads
+// whose spans never outgrow their inline storage do not contend on it.
+class SpanPool {
+  public:
+    struct Buffers {
+        Span::Tags _tags;
+        Span::Logs _logs;
+        Span::References _references;
+        utils::Arena _arena;
+    };
+
+    static constexpr size_t kThreadCacheSize = 64;
+    static constexpr size_t kSharedSize = 1024;
+    // Vectors grown beyond this many elements, and arenas with a chunk
+    // larger than utils::Arena::kMaxChunkSize, are not kept, so that a few
+    // unusual spans do not pin their memory.
+    static constexpr size_t kMaxCapacity = 256;
+
+    explicit SpanPool(metrics::Metrics& metrics);
+
+    SpanPool(const SpanPool&) = delete;
+
+    SpanPool& operator=(const SpanPool&) = delete;
+
+    // Returns empty vectors, with the capacity of earlier spans when the
+    // pool has some, which counts as a hit.
+    Buffers acquire();
+
+    void release(Buffers&& buffers);
+
+  private:
+    struct Shared {
+        Shared()
+            : _mutex()
+            , _buffers()
+            , _size(0)
+        {
+        }
+
+        std::mutex _mutex;
+        std::vector<Buffers> _buffers;
+        // _buffers.size(), read without the mutex.
+        std::atomic<size_t> _size;
+    };
+
+    class ThreadCaches;
+
+    static void
+    spill(Shared& shared, std::vector<Buffers>& cache, size_t count);
+
+    std::vector<Buffers>& threadCache();
+
+    metrics::Metrics& _metrics;
+    uint64_t _id;
+    // Shared with the thread-local freelists, which outlive the pool when
+    // their thread exits after the tracer is gone.
+    std::shared_ptr<Shared> _shared;
+};
+
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_SPANPOOL_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/SpanPool.h"
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
+#include "jaegertracing/metrics/Metrics.h"
+#include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace jaegertracing {
+namespace {
+
+int64_t poolCount(const metrics::InMemoryStatsReporter& stats,
+                  const std::string& result)
+{
+    const auto itr = stats.counters().find(
+        metrics::Metrics::addTagsToMetricName("jaeger.span-pool",
+                                              { { "result", result } }));
+    return (itr == std::end(stats.counters())) ? 0 : itr->second;
+}
+
+int64_t refillCount(const metrics::InMemoryStatsReporter& stats)
+{
+    const auto itr = stats.counters().find("jaeger.span-pool-refills");
+    return (itr == std::end(stats.counters())) ? 0 : itr->second;
+}
+
+constexpr auto kInlineTags = Span::Tags::kInlineCapacity;
+
+SpanPool::Buffers makeBuffers(size_t numTags)
+{
+    SpanPool::Buffers buffers;
+    for (size_t i = 0; i < numTags; ++i) {
+        buffers._tags.emplace_back("key", static_cast<int64_t>(i));
+    }
+    return buffers;
+}
+
+}  // anonymous namespace
+
+TEST(SpanPool, testKeepsCapacity)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    SpanPool pool(*metrics);
+
+    ASSERT_EQ(kInlineTags, pool.acquire()._tags.capacity());
+    ASSERT_EQ(1, poolCount(stats, "miss"));
+
+    pool.release(makeBuffers(kInlineTags + 1));
+    const auto buffers = pool.acquire();
+    ASSERT_TRUE(buffers._tags.empty());
+    ASSERT_GT(buffers._tags.capacity(), kInlineTags);
+    ASSERT_EQ(1, poolCount(stats, "hit"));
+
+    // Vectors that fit inline or grew very large are not kept.
+    pool.release(makeBuffers(kInlineTags));
+    pool.release(makeBuffers(SpanPool::kMaxCapacity + 1));
+    ASSERT_EQ(kInlineTags, pool.acquire()._tags.capacity());
+    ASSERT_EQ(2, poolCount(stats, "miss"));
+}
+
+TEST(SpanPool, testMissesDoNotLockSharedList)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    SpanPool pool(*metrics);
+
+    // Like unsampled spans without tags: nothing outgrows its inline
+    // storage, so nothing is kept and every start misses...
+    constexpr auto kNumSpans = 1000;
+    for (auto i = 0; i < kNumSpans; ++i) {
+        pool.release(pool.acquire());
+    }
+    ASSERT_EQ(kNumSpans, poolCount(stats, "miss"));
+    // ...without ever locking the empty shared list.
+    ASSERT_EQ(0, refillCount(stats));
+}
+
+TEST(SpanPool, testKeepsArena)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    SpanPool pool(*metrics);
+
+    SpanPool::Buffers buffers;
+    buffers._arena.copy("value");
+    const auto capacity = buffers._arena.capacity();
+    pool.release(std::move(buffers));
+    ASSERT_EQ(capacity, pool.acquire()._arena.capacity());
+    ASSERT_EQ(1, poolCount(stats, "hit"));
+
+    SpanPool::Buffers large;
+    large._arena.copy(std::string(utils::Arena::kMaxChunkSize + 1, 'x'));
+    pool.release(std::move(large));
+    ASSERT_EQ(0, pool.acquire()._arena.capacity());
+    ASSERT_EQ(1, poolCount(stats, "miss"));
+}
+
+TEST(SpanPool, testSharesAcrossThreads)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    SpanPool pool(*metrics);
+
+    // Released on a thread that never acquires, like the reporter's.
+    std::thread releaser([&pool]() {
+        for (size_t i = 0; i < 2 * SpanPool::kThreadCacheSize; ++i) {
+            pool.release(makeBuffers(kInlineTags + 1));
+        }
+    });
+    releaser.join();
+
+    for (size_t i = 0; i < 2 * SpanPool::kThreadCacheSize; ++i) {
+        ASSERT_GT(pool.acquire()._tags.capacity(), kInlineTags);
+    }
+    ASSERT_EQ(kInlineTags, pool.acquire()._tags.capacity());
+    ASSERT_EQ(1, poolCount(stats, "miss"));
+    ASSERT_GT(refillCount(stats), 0);
+}
+
+}  // namespace jaegertracing
@@ -16,8 +16,13 @@
 
 #include "jaegertracing/Span.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/CompactWriter.h"
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
 
 namespace jaegertracing {
 
@@ -30,4 +35,60 @@ TEST(Span, testThriftConversion)
     ASSERT_NO_THROW(span.thrift(thriftSpan));
 }
 
+TEST(Span, testCompactEncoding)
+{
+    using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+
+    const SpanContext parent(TraceID(1, 2), 3, 0, 1, SpanContext::StrMap());
+    std::vector<Tag> tags = { Tag("string", std::string("value")),
+                              Tag("c-string", "value"),
+                              Tag("double", 1.5),
+                              Tag("bool", true),
+                              Tag("false", false),
+                              Tag("int", static_cast<int64_t>(-42)),
+                              Tag("uint", static_cast<uint64_t>(42)),
+                              Tag("null", nullptr) };
+    // Long enough for the long form of the list header.
+    for (auto i = 0; i < 20; ++i) {
+        tags.push_back(
+            Tag("tag-" + std::to_string(i), static_cast<int64_t>(i)));
+    }
+    Span span(nullptr,
+              SpanContext(TraceID(1, 2), 4, 3, 1, SpanContext::StrMap()),
+              "operation",
+              Span::SystemClock::now(),
+              Span::SteadyClock::now(),
+              tags,
+              { Reference(parent, Reference::Type::ChildOfRef),
+                Reference(parent, Reference::Type::FollowsFromRef) });
+    span.Log({ { "event", "error" }, { "count", 2 } });
+    span.Log({ { "message", std::string(200, 'x') } });
+
+    thrift::Span thriftSpan;
+    span.thrift(thriftSpan);
+    std::shared_ptr<TMemoryBuffer> thriftBuffer(new TMemoryBuffer());
+    apache::thrift::protocol::TCompactProtocolFactory protocolFactory;
+    thriftSpan.write(protocolFactory.getProtocol(thriftBuffer).get());
+
+    std::string buffer;
+    utils::CompactWriter writer(buffer);
+    span.encode(writer);
+    ASSERT_EQ(thriftBuffer->getBufferAsString(), buffer);
+}
+
+TEST(Span, testEstimatedSize)
+{
+    const Span span;
+    const std::string value(1000, 'x');
+    const Span taggedSpan(nullptr,
+                          SpanContext(),
+                          "",
+                          Span::SystemClock::now(),
+                          Span::SteadyClock::now(),
+                          { Tag("key", value) });
+    ASSERT_GE(span.estimatedSize(), sizeof(Span));
+    ASSERT_GE(taggedSpan.estimatedSize(),
+              span.estimatedSize() + value.size());
+}
+
 }  // namespace jaegertracing
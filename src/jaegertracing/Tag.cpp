@@ -16,8 +16,130 @@
 
 #include "jaegertracing/Tag.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/Arena.h"
+#include "jaegertracing/utils/CompactWriter.h"
+
+#include <cstring>
 
 namespace jaegertracing {
+namespace {
+
+struct SizeVisitor {
+    using result_type = size_t;
+
+    size_t operator()(const std::string& value) const { return value.size(); }
+
+    size_t operator()(const char* value) const
+    {
+        return value ? std::strlen(value) : 0;
+    }
+
+    size_t operator()(opentracing::string_view value) const
+    {
+        return value.size();
+    }
+
+    template <typename Arg>
+    size_t operator()(Arg&&) const
+    {
+        return 0;
+    }
+};
+
+// Moves string values into an arena.
+class ArenaVisitor {
+  public:
+    using result_type = Tag::ValueType;
+
+    explicit ArenaVisitor(utils::Arena& arena)
+        : _arena(arena)
+    {
+    }
+
+    Tag::ValueType operator()(const std::string& value) const
+    {
+        return _arena.copy(value);
+    }
+
+    Tag::ValueType operator()(const char* value) const
+    {
+        return value ? _arena.copy(value) : opentracing::string_view();
+    }
+
+    Tag::ValueType operator()(opentracing::string_view value) const
+    {
+        return _arena.copy(value);
+    }
+
+    template <typename Arg>
+    Tag::ValueType operator()(const Arg& value) const
+    {
+        return value;
+    }
+
+  private:
+    utils::Arena& _arena;
+};
+
+// Copies string values out of an arena.
+struct OwnedVisitor {
+    using result_type = Tag::ValueType;
+
+    Tag::ValueType operator()(opentracing::string_view value) const
+    {
+        return std::string(value.data(), value.size());
+    }
+
+    template <typename Arg>
+    Tag::ValueType operator()(const Arg& value) const
+    {
+        return value;
+    }
+};
+
+// Views a string value, whichever type holds it.
+class StringVisitor {
+  public:
+    using result_type = bool;
+
+    explicit StringVisitor(opentracing::string_view& value)
+        : _value(value)
+    {
+    }
+
+    bool operator()(const std::string& value) const
+    {
+        _value = value;
+        return true;
+    }
+
+    bool operator()(const char* value) const
+    {
+        if (!value) {
+            return false;
+        }
+        _value = value;
+        return true;
+    }
+
+    bool operator()(opentracing::string_view value) const
+    {
+        _value = value;
+        return true;
+    }
+
+    template <typename Arg>
+    bool operator()(const Arg&) const
+    {
+        return false;
+    }
+
+  private:
+    opentracing::string_view& _value;
+};
+
+}  // anonymous namespace
+
 class ThriftVisitor {
   public:
     using result_type = void;
@@ -31,6 +153,11 @@ class ThriftVisitor {
 
     void operator()(const char* value) const { setString(value); }
 
+    void operator()(opentracing::string_view value) const
+    {
+        setString(value);
+    }
+
     void operator()(double value) const
     {
         _tag.__set_vType(thrift::TagType::DOUBLE);
@@ -69,11 +196,131 @@ class ThriftVisitor {
     thrift::Tag& _tag;
 };
 
+namespace {
+
+// Writes the fields following the key, mirroring ThriftVisitor.
+class EncodeVisitor {
+  public:
+    using result_type = void;
+
+    explicit EncodeVisitor(utils::CompactWriter& writer)
+        : _writer(writer)
+    {
+    }
+
+    void operator()(const std::string& value) const { writeString(value); }
+
+    void operator()(const char* value) const { writeString(value); }
+
+    void operator()(opentracing::string_view value) const
+    {
+        writeString(value);
+    }
+
+    void operator()(double value) const
+    {
+        _writer.writeI32Field(2, thrift::TagType::DOUBLE);
+        _writer.writeDoubleField(4, value);
+    }
+
+    void operator()(bool value) const
+    {
+        _writer.writeI32Field(2, thrift::TagType::BOOL);
+        _writer.writeBoolField(5, value);
+    }
+
+    void operator()(int64_t value) const { writeLong(value); }
+
+    void operator()(uint64_t value) const { writeLong(value); }
+
+    template <typename Arg>
+    void operator()(Arg&& value) const
+    {
+        // Only the default type, as thrift() leaves the tag untouched.
+        _writer.writeI32Field(2, thrift::TagType::STRING);
+    }
+
+  private:
+    void writeString(opentracing::string_view value) const
+    {
+        _writer.writeI32Field(2, thrift::TagType::STRING);
+        _writer.writeStringField(3, value);
+    }
+
+    void writeLong(int64_t value) const
+    {
+        _writer.writeI32Field(2, thrift::TagType::LONG);
+        _writer.writeI64Field(6, value);
+    }
+
+    utils::CompactWriter& _writer;
+};
+
+}  // anonymous namespace
+
+Tag::Tag(opentracing::string_view key,
+         const ValueType& value,
+         utils::Arena& arena)
+    : _key()
+    , _arenaKey(arena.copy(key))
+    , _value(opentracing::util::apply_visitor(ArenaVisitor(arena), value))
+{
+}
+
+Tag::Tag(const Tag& tag)
+    : _key(tag.key().data(), tag.key().size())
+    , _arenaKey()
+    , _value(opentracing::util::apply_visitor(OwnedVisitor(), tag._value))
+{
+}
+
+Tag& Tag::operator=(const Tag& tag)
+{
+    if (this != &tag) {
+        *this = Tag(tag);
+    }
+    return *this;
+}
+
+bool Tag::operator==(const Tag& rhs) const
+{
+    if (!(key() == rhs.key())) {
+        return false;
+    }
+    opentracing::string_view value;
+    opentracing::string_view rhsValue;
+    if (opentracing::util::apply_visitor(StringVisitor(value), _value) &&
+        opentracing::util::apply_visitor(StringVisitor(rhsValue),
+                                         rhs._value)) {
+        return value == rhsValue;
+    }
+    return _value == rhs._value;
+}
+
 void Tag::thrift(thrift::Tag& tag) const
 {
-    tag.__set_key(_key);
+    tag.__set_key(key());
     ThriftVisitor visitor(tag);
     opentracing::util::apply_visitor(visitor, _value);
 }
 
-}  // namespace jaegertracing
\ No newline at end of file
+void Tag::encode(utils::CompactWriter& writer) const
+{
+    const auto lastFieldId = writer.writeStructBegin();
+    writer.writeStringField(1, key());
+    EncodeVisitor visitor(writer);
+    opentracing::util::apply_visitor(visitor, _value);
+    writer.writeStructEnd(lastFieldId);
+}
+
+size_t Tag::estimatedSize() const
+{
+    if (_arenaKey.data()) {
+        // The strings are counted with the arena.
+        return sizeof(Tag);
+    }
+    return sizeof(Tag) + _key.size() +
+           opentracing::util::apply_visitor(SizeVisitor(), _value);
+}
+
+}  // namespace jaegertracing
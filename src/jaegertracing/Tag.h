@@ -30,6 +30,10 @@ namespace jaegertracing {
 namespace thrift {
 class Tag;
 }
+namespace utils {
+class Arena;
+class CompactWriter;
+}
 
 class Tag {
   public:
@@ -49,19 +53,47 @@ class Tag {
     {
     }
 
-    bool operator==(const Tag& rhs) const
+    // Copies the key and a string value into `arena` and only refers to
+    // them, so the tag must not outlive the arena.
+    Tag(opentracing::string_view key,
+        const ValueType& value,
+        utils::Arena& arena);
+
+    // Copies own their key and string value, since they may outlive the
+    // arena or the strings the original refers to. Moves do not copy.
+    Tag(const Tag& tag);
+
+    Tag(Tag&& tag) = default;
+
+    Tag& operator=(const Tag& tag);
+
+    Tag& operator=(Tag&& tag) = default;
+
+    // String values are equal if their contents are, however they are held.
+    bool operator==(const Tag& rhs) const;
+
+    opentracing::string_view key() const
     {
-        return _key == rhs._key && _value == rhs._value;
+        return _arenaKey.data() ? _arenaKey : opentracing::string_view(_key);
     }
 
-    const std::string& key() const { return _key; }
-
     const ValueType& value() const { return _value; }
 
+    // Copy that owns its key and string value, for tags handed out by a span.
+    Tag owned() const { return *this; }
+
     void thrift(thrift::Tag& tag) const;
 
+    void encode(utils::CompactWriter& writer) const;
+
+    // Approximate number of bytes this tag keeps alive, including the heap
+    // memory of its key and string value.
+    size_t estimatedSize() const;
+
   private:
+    // Tags in an arena leave `_key` empty.
     std::string _key;
+    opentracing::string_view _arenaKey;
     ValueType _value;
 };
 
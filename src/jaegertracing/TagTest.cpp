@@ -16,7 +16,9 @@
 
 #include "jaegertracing/Tag.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/Arena.h"
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
 
 namespace jaegertracing {
@@ -37,4 +39,27 @@ TEST(Tag, testThriftConversion)
     }
 }
 
+TEST(Tag, testCopyOutlivesArena)
+{
+    std::unique_ptr<utils::Arena> arena(new utils::Arena());
+    const Tag arenaTag("key", std::string("value"), *arena);
+    const Tag copy(arenaTag);
+    Tag assigned("other", 1);
+    assigned = arenaTag;
+    arena.reset();
+
+    ASSERT_EQ(Tag("key", std::string("value")), copy);
+    ASSERT_EQ(Tag("key", std::string("value")), assigned);
+}
+
+TEST(Tag, testStringValuesCompareByContent)
+{
+    utils::Arena arena;
+    const Tag arenaTag("key", std::string("value"), arena);
+    ASSERT_EQ(Tag("key", std::string("value")), arenaTag);
+    ASSERT_EQ(Tag("key", "value"), arenaTag);
+    ASSERT_FALSE(Tag("key", std::string("other")) == arenaTag);
+    ASSERT_FALSE(Tag("key", 1) == arenaTag);
+}
+
 }  // namespace jaegertracing
@@ -19,10 +19,12 @@
 #include "jaegertracing/Span.h"
 #include "jaegertracing/Tag.h"
 #include "jaegertracing/Tracer.h"
+#include "jaegertracing/utils/CompactWriter.h"
 #include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <thrift/protocol/TCompactProtocol.h>
 #include <thrift/transport/TBufferTransports.h>
 
 #ifdef _MSC_VER
@@ -38,95 +40,372 @@ class IPAddress;
 namespace {
 
 constexpr auto kEmitBatchOverhead = 30;
+constexpr auto kEncodeBufferSize = 1024;
+
+class ThriftSerializedSpan : public Sender::SerializedSpan {
+  public:
+    ThriftSerializedSpan(const Tracer& tracer, std::string&& span)
+        : _tracer(tracer)
+        , _span(std::move(span))
+    {
+    }
+
+    const Tracer& tracer() const { return _tracer; }
+
+    std::string& span() { return _span; }
+
+  private:
+    const Tracer& _tracer;
+    std::string _span;
+};
 
 }  // anonymous namespace
 
-ThriftSender::ThriftSender(std::unique_ptr<utils::Transport>&& transporter)
+constexpr int ThriftSender::kCircuitBreakerThreshold;
+
+ThriftSender::ThriftSender(std::unique_ptr<utils::Transport>&& transporter,
+                           int64_t retryBufferSize,
+                           const Clock::duration& minBackoff,
+                           const Clock::duration& maxBackoff)
     : _transporter(std::move(transporter))
     , _maxSpanBytes(0)
     , _byteBufferSize(0)
+    , _processTracer(nullptr)
     , _processByteSize(0)
     , _protocolFactory(_transporter->protocolFactory())
     , _thriftBuffer(new apache::thrift::transport::TMemoryBuffer())
+    , _compactProtocol(
+          dynamic_cast<apache::thrift::protocol::TCompactProtocolFactory*>(
+              _protocolFactory.get()) != nullptr)
+    , _spanCount(0)
+    , _retryBufferSize(retryBufferSize)
+    , _minBackoff(minBackoff)
+    , _maxBackoff(std::max(minBackoff, maxBackoff))
+    , _batches()
+    , _batchBytes(0)
+    , _sendList()
+    , _failures(0)
+    , _nextAttempt()
+    , _randomNumberGenerator(std::random_device()())
+    , _numFailed(0)
+    , _errorPending(false)
 {
+    _encodeBuffer.reserve(kEncodeBufferSize);
 }
 
 int ThriftSender::append(const Span& span)
 {
-    if (_process.serviceName.empty()) {
-        const auto& tracer = static_cast<const Tracer&>(span.tracer());
-        _process.serviceName = tracer.serviceName();
-
-        const auto& tracerTags = tracer.tags();
-        std::vector<thrift::Tag> thriftTags;
-        thriftTags.reserve(tracerTags.size());
-        std::transform(std::begin(tracerTags),
-                       std::end(tracerTags),
-                       std::back_inserter(thriftTags),
-                       [](const Tag& tag) {
-                           thrift::Tag thriftTag;
-                           tag.thrift(thriftTag);
-                           return thriftTag;
-                       });
-        _process.__set_tags(thriftTags);
-
-        _processByteSize = calcSizeOfSerializedThrift(_process);
-        _maxSpanBytes =
-            _transporter->maxPacketSize() - _processByteSize - kEmitBatchOverhead;
+    if (circuitOpen()) {
+        ++_numFailed;
+        return 0;
     }
+    encode(span, _encodeBuffer);
+    return appendEncoded(static_cast<const Tracer&>(span.tracer()),
+                         _encodeBuffer);
+}
+
+std::unique_ptr<Sender::SerializedSpan>
+ThriftSender::serialize(std::unique_ptr<Span>&& span) const
+{
+    std::string buffer;
+    encode(*span, buffer);
+    return std::unique_ptr<SerializedSpan>(new ThriftSerializedSpan(
+        static_cast<const Tracer&>(span->tracer()), std::move(buffer)));
+}
+
+int ThriftSender::appendSerialized(std::unique_ptr<SerializedSpan>&& span)
+{
+    if (circuitOpen()) {
+        ++_numFailed;
+        return 0;
+    }
+    auto& serialized = static_cast<ThriftSerializedSpan&>(*span);
+    return appendEncoded(serialized.tracer(), serialized.span());
+}
+
+void ThriftSender::encode(const Span& span, std::string& buffer) const
+{
+    buffer.clear();
+    if (_compactProtocol) {
+        utils::CompactWriter writer(buffer);
+        span.encode(writer);
+        return;
+    }
+
+    // Other protocols go through the generated code. One buffer per thread
+    // so that concurrent serialize() calls do not share state.
+    static thread_local std::shared_ptr<
+        apache::thrift::transport::TMemoryBuffer>
+        thriftBuffer(new apache::thrift::transport::TMemoryBuffer());
     thrift::Span jaegerSpan;
     span.thrift(jaegerSpan);
-    const auto spanSize = calcSizeOfSerializedThrift(jaegerSpan);
+    thriftBuffer->resetBuffer();
+    auto protocol = _protocolFactory->getProtocol(thriftBuffer);
+    jaegerSpan.write(protocol.get());
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    thriftBuffer->getBuffer(&data, &size);
+    buffer.append(reinterpret_cast<const char*>(data), size);
+}
+
+int ThriftSender::appendEncoded(const Tracer& tracer, const std::string& span)
+{
+    // Spans nearly always come from the tracer that owns this sender, so the
+    // process is only looked at again when the tracer changes.
+    auto flushed = 0;
+    if (&tracer != _processTracer) {
+        flushed = updateProcess(tracer);
+    }
+
+    const auto spanSize = static_cast<int>(span.size());
     if (spanSize > _maxSpanBytes) {
-        std::ostringstream oss;
-        throw Sender::Exception("Span is too large", 1);
+        ++_numFailed;
+        _errorPending = true;
+        _error = "Span is too large";
+        return report(flushed);
     }
 
     _byteBufferSize += spanSize;
     if (_byteBufferSize <= _maxSpanBytes) {
-        _spanBuffer.push_back(jaegerSpan);
-        if (_byteBufferSize < _maxSpanBytes) {
-            return 0;
+        _spanBuffer.append(span);
+        ++_spanCount;
+        if (_byteBufferSize == _maxSpanBytes) {
+            flushed += sendFullBatch();
         }
-        return flush();
+        return report(flushed);
     }
 
     // Flush currently full buffer, then append this span to buffer.
-    const auto flushed = flush();
-    _spanBuffer.push_back(jaegerSpan);
+    flushed += sendFullBatch();
+    _spanBuffer.append(span);
+    ++_spanCount;
     _byteBufferSize = spanSize + _processByteSize;
+    return report(flushed);
+}
+
+int ThriftSender::updateProcess(const Tracer& tracer)
+{
+    if (_processBytes && tracer.serviceName() == _processServiceName &&
+        tracer.tags() == _processTags) {
+        _processTracer = &tracer;
+        return 0;
+    }
+
+    // Buffered spans belong to the previous process.
+    const auto flushed = sendFullBatch();
+
+    thrift::Process process;
+    process.serviceName = tracer.serviceName();
+
+    const auto& tracerTags = tracer.tags();
+    std::vector<thrift::Tag> thriftTags;
+    thriftTags.reserve(tracerTags.size());
+    std::transform(std::begin(tracerTags),
+                   std::end(tracerTags),
+                   std::back_inserter(thriftTags),
+                   [](const Tag& tag) {
+                       thrift::Tag thriftTag;
+                       tag.thrift(thriftTag);
+                       return thriftTag;
+                   });
+    process.__set_tags(thriftTags);
+
+    _thriftBuffer->resetBuffer();
+    auto protocol = _protocolFactory->getProtocol(_thriftBuffer);
+    process.write(protocol.get());
+    _processBytes = std::make_shared<const std::string>(
+        _thriftBuffer->getBufferAsString());
+
+    _processTracer = &tracer;
+    _processServiceName = tracer.serviceName();
+    _processTags = tracer.tags();
+    _processByteSize = static_cast<int>(_processBytes->size());
+    updatePacketSize();
+    reserveSpanBuffer();
+    resetBuffers();
     return flushed;
 }
 
-int ThriftSender::flush()
+void ThriftSender::reserveSpanBuffer()
+{
+    // A streaming transport keeps no copy of the batch, so most of the
+    // memory a batch takes is here; let it grow with the spans instead of
+    // holding the largest batch size all the time.
+    if (_maxSpanBytes > 0 && !_transporter->streamsBatches()) {
+        _spanBuffer.reserve(_maxSpanBytes);
+    }
+}
+
+void ThriftSender::updatePacketSize()
 {
-    if (_spanBuffer.empty()) {
+    _maxSpanBytes = _transporter->targetPacketSize() - _processByteSize -
+                    kEmitBatchOverhead;
+}
+
+int ThriftSender::flush() { return report(send()); }
+
+int ThriftSender::sendFullBatch()
+{
+    // Hold full batches back until the transport can send them together.
+    if (_failures == 0 && static_cast<int>(_batches.size()) + 1 <
+                              _transporter->maxBatchesPerSend()) {
+        queueBatch();
+        return 0;
+    }
+    return send();
+}
+
+int ThriftSender::send()
+{
+    // The current batch was built for the previous size, and is sent anyway.
+    updatePacketSize();
+    if (_spanCount == 0 && _batches.empty()) {
+        return 0;
+    }
+    if (_failures > 0 && Clock::now() < _nextAttempt) {
+        retryLater();
         return 0;
     }
 
-    thrift::Batch batch;
-    batch.__set_process(_process);
-    batch.__set_spans(_spanBuffer);
+    _sendList.clear();
+    for (auto&& batch : _batches) {
+        utils::Transport::SerializedBatch serialized;
+        serialized._process = batch._process.get();
+        serialized._spans = &batch._spans;
+        serialized._numSpans = batch._numSpans;
+        _sendList.push_back(serialized);
+    }
+    // The current batch is sent from the live buffers, and only moved to
+    // the queue if it has to be kept for a retry.
+    if (_spanCount > 0) {
+        utils::Transport::SerializedBatch serialized;
+        serialized._process = _processBytes.get();
+        serialized._spans = &_spanBuffer;
+        serialized._numSpans = _spanCount;
+        _sendList.push_back(serialized);
+    }
 
+    size_t numSent = 0;
+    auto failed = true;
+    std::string error;
     try {
-      _transporter->emitBatch(batch);
+        _transporter->emitSerializedBatches(_sendList, numSent);
+        failed = false;
     } catch (const std::system_error& ex) {
         std::ostringstream oss;
         oss << "Could not send span " << ex.what()
             << ", code=" << ex.code().value();
-        throw Sender::Exception(oss.str(), _spanBuffer.size());
+        error = oss.str();
     } catch (const std::exception& ex) {
         std::ostringstream oss;
         oss << "Could not send span " << ex.what();
-        throw Sender::Exception(oss.str(), _spanBuffer.size());
+        error = oss.str();
     } catch (...) {
-        throw Sender::Exception("Could not send span, unknown error",
-                                _spanBuffer.size());
+        error = "Could not send span, unknown error";
+    }
+
+    auto sent = 0;
+    const auto numQueuedSent = std::min(numSent, _batches.size());
+    for (size_t i = 0; i < numQueuedSent; ++i) {
+        sent += _batches.front()._numSpans;
+        _batchBytes -= _batches.front()._size;
+        _batches.pop_front();
+    }
+    if (numSent > numQueuedSent) {
+        sent += _spanCount;
+        resetBuffers();
+    }
+    if (failed) {
+        onFailure(error);
+    }
+    else {
+        _failures = 0;
+    }
+    updatePacketSize();
+    // Asynchronous transporters count spans once they are acknowledged.
+    return _transporter->asynchronous() ? 0 : sent;
+}
+
+void ThriftSender::onFailure(const std::string& error)
+{
+    _errorPending = true;
+    _error = error;
+    // Without a retry buffer, the failed batch is dropped and the next one
+    // is tried as usual.
+    if (_retryBufferSize > 0) {
+        ++_failures;
+        _nextAttempt = Clock::now() + backoff();
     }
+    retryLater();
+}
 
+void ThriftSender::queueBatch()
+{
+    if (_spanCount == 0) {
+        return;
+    }
+    PendingBatch batch;
+    batch._process = _processBytes;
+    batch._numSpans = _spanCount;
+    batch._size =
+        static_cast<int64_t>(_processBytes->size() + _spanBuffer.size());
+    batch._spans.swap(_spanBuffer);
+    _batchBytes += batch._size;
+    _batches.push_back(std::move(batch));
+    reserveSpanBuffer();
     resetBuffers();
+}
+
+void ThriftSender::retryLater()
+{
+    queueBatch();
+    // Batches built for larger packets than the transporter now sends would
+    // fail again.
+    const auto packetSize = _transporter->targetPacketSize();
+    for (auto batch = _batches.begin(); batch != _batches.end();) {
+        if (batch->_size + kEmitBatchOverhead > packetSize) {
+            _numFailed += batch->_numSpans;
+            _batchBytes -= batch->_size;
+            batch = _batches.erase(batch);
+        }
+        else {
+            ++batch;
+        }
+    }
+    // Keep the most recent spans.
+    while (_batchBytes > _retryBufferSize) {
+        _numFailed += _batches.front()._numSpans;
+        _batchBytes -= _batches.front()._size;
+        _batches.pop_front();
+    }
+}
+
+ThriftSender::Clock::duration ThriftSender::backoff()
+{
+    // Doubles with each consecutive failure, capped at _maxBackoff.
+    auto backoff = _minBackoff;
+    for (auto i = 1; i < _failures && backoff < _maxBackoff; ++i) {
+        backoff *= 2;
+    }
+    backoff = std::min(backoff, _maxBackoff);
+
+    // Jitter keeps senders that failed together from retrying together.
+    std::uniform_int_distribution<Clock::rep> distribution(
+        backoff.count() / 2, backoff.count());
+    return Clock::duration(distribution(_randomNumberGenerator));
+}
 
-    return batch.spans.size();
+int ThriftSender::report(int numSent)
+{
+    if (_numFailed == 0 && !_errorPending) {
+        return numSent;
+    }
+    const auto numFailed = _numFailed;
+    const auto error = _errorPending ? _error : std::string("Spans dropped");
+    _numFailed = 0;
+    _errorPending = false;
+    _error.clear();
+    throw Sender::Exception(error, numFailed, numSent);
 }
 
 }  // namespace jaegertracing
@@ -1,80 +1,193 @@
-/*
- * Copyright (c) 2017-2018 Uber Technologies, Inc.
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#ifndef JAEGERTRACING_THRIFTSENDER_H
-#define JAEGERTRACING_THRIFTSENDER_H
-
-#include "jaegertracing/Compilers.h"
-#include "jaegertracing/Span.h"
-#include "jaegertracing/Sender.h"
-#include "jaegertracing/thrift-gen/jaeger_types.h"
-#include "jaegertracing/utils/Transport.h"
-#include <thrift/transport/TBufferTransports.h>
-
-namespace jaegertracing {
-
-class ThriftSender : public Sender {
-  public:
-    ThriftSender(std::unique_ptr<utils::Transport>&& transporter);
-
-    ~ThriftSender() { close(); }
-
-    int append(const Span& span) override;
-
-    int flush() override;
-
-    void close() override { _transporter->close(); }
-
-  protected:
-    void setClient(std::unique_ptr<utils::Transport>&& client)
-    {
-      _transporter = std::move(client);
-    }
-
-  private:
-    void resetBuffers()
-    {
-        _spanBuffer.clear();
-        _byteBufferSize = _processByteSize;
-    }
-
-    template <typename ThriftType>
-    int calcSizeOfSerializedThrift(const ThriftType& base)
-    {
-        _thriftBuffer->resetBuffer();
-        auto _protocol = _protocolFactory->getProtocol(_thriftBuffer);
-        base.write(_protocol.get());
-        uint8_t* data = nullptr;
-        uint32_t size = 0;
-        _thriftBuffer->getBuffer(&data, &size);
-        return size;
-    }
-
-    std::unique_ptr<utils::Transport> _transporter;
-    int _maxSpanBytes;
-    int _byteBufferSize;
-    std::vector<thrift::Span> _spanBuffer;
-    thrift::Process _process;
-    int _processByteSize;
-    std::unique_ptr<apache::thrift::protocol::TProtocolFactory> _protocolFactory;
-    // reuse buffer across serializations of different ThriftType for size
-    // calculation
-    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _thriftBuffer;
-};
-
-}  // namespace jaegertracing
-
-#endif  //JAEGERTRACING_THRIFTSENDER_H
+/*
+ * Copyright (c) 2017-2018 Uber Technologies, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_THRIFTSENDER_H
+#define JAEGERTRACING_THRIFTSENDER_H
+
+#include "jaegertracing/Compilers.h"
+#include "jaegertracing/Span.h"
+#include "jaegertracing/Sender.h"
+#include "jaegertracing/thrift-gen/jaeger_types.h"
+#include "jaegertracing/utils/Transport.h"
+#include <thrift/transport/TBufferTransports.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace jaegertracing {
+
+// Batches spans up to the transport's target packet size, which may change
+// as sends fail or succeed. With a `retryBufferSize` of 0, the default, a
+// batch that fails to send is dropped and the next one is sent as usual.
+// Otherwise the batch is kept in a retry buffer of up to `retryBufferSize`
+// bytes, dropping batches too large for the new target size and the oldest
+// batches when full, and sending is suspended for an exponential, jittered
+// backoff between `minBackoff` and `maxBackoff`. After
+// kCircuitBreakerThreshold consecutive failures, spans are then dropped
+// without being encoded until the backoff expires and a send succeeds again.
+// Spans dropped are reported as failed by the next append() or flush() that
+// throws.
+class ThriftSender : public Sender {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto kCircuitBreakerThreshold = 3;
+
+    static Clock::duration defaultMinBackoff()
+    {
+        return std::chrono::milliseconds(100);
+    }
+
+    static Clock::duration defaultMaxBackoff()
+    {
+        return std::chrono::seconds(10);
+    }
+
+    ThriftSender(std::unique_ptr<utils::Transport>&& transporter,
+                 int64_t retryBufferSize = 0,
+                 const Clock::duration& minBackoff = defaultMinBackoff(),
+                 const Clock::duration& maxBackoff = defaultMaxBackoff());
+
+    ~ThriftSender() { close(); }
+
+    int append(const Span& span) override;
+
+    std::unique_ptr<SerializedSpan>
+    serialize(std::unique_ptr<Span>&& span) const override;
+
+    int appendSerialized(std::unique_ptr<SerializedSpan>&& span) override;
+
+    int flush() override;
+
+    void close() override { _transporter->close(); }
+
+  protected:
+    void setClient(std::unique_ptr<utils::Transport>&& client)
+    {
+      _transporter = std::move(client);
+    }
+
+  private:
+    // Replaces the contents of `buffer` with the encoding of `span` in the
+    // transport's protocol.
+    void encode(const Span& span, std::string& buffer) const;
+
+    // Buffers the encoded span, flushing first if it does not fit.
+    int appendEncoded(const Tracer& tracer, const std::string& span);
+
+    // Encodes the process of `tracer` unless it matches the current one,
+    // flushing spans of the previous process first.
+    int updateProcess(const Tracer& tracer);
+
+    // Fits batches yet to be built to the transport's current target packet
+    // size.
+    void updatePacketSize();
+
+    bool circuitOpen() const
+    {
+        return _failures >= kCircuitBreakerThreshold &&
+               Clock::now() < _nextAttempt;
+    }
+
+    // Queues the current batch, which cannot take more spans, and sends
+    // the queue once it has as many batches as the transport can send at
+    // once.
+    int sendFullBatch();
+
+    // Sends the queued batches, oldest first, then the current batch,
+    // unless backing off. Returns the number of spans sent; failures are
+    // recorded for report().
+    int send();
+
+    void onFailure(const std::string& error);
+
+    // Moves the current batch to the back of the queue.
+    void queueBatch();
+
+    // Queues the current batch for a retry and drops batches too large for
+    // the target packet size, then the oldest batches beyond the retry
+    // buffer size.
+    void retryLater();
+
+    Clock::duration backoff();
+
+    // Throws a Sender::Exception for failures since the last report, or
+    // returns `numSent`.
+    int report(int numSent);
+
+    // Makes room for a full batch in _spanBuffer, unless the transport
+    // streams batches.
+    void reserveSpanBuffer();
+
+    void resetBuffers()
+    {
+        _spanBuffer.clear();
+        _spanCount = 0;
+        _byteBufferSize = _processByteSize;
+    }
+
+    std::unique_ptr<utils::Transport> _transporter;
+    int _maxSpanBytes;
+    int _byteBufferSize;
+    // The process is encoded once and sent as it is in every batch, and
+    // shared with the queued ones.
+    const Tracer* _processTracer;
+    std::string _processServiceName;
+    std::vector<Tag> _processTags;
+    std::shared_ptr<const std::string> _processBytes;
+    int _processByteSize;
+    std::unique_ptr<apache::thrift::protocol::TProtocolFactory> _protocolFactory;
+    // reused when the process is encoded
+    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _thriftBuffer;
+    // Spans are written by Span::encode() rather than the generated code
+    // when the transport uses the compact protocol.
+    bool _compactProtocol;
+    // Encoded spans back to back, sent as they are. Keeps its capacity
+    // across batches, as does _encodeBuffer.
+    std::string _spanBuffer;
+    int _spanCount;
+    std::string _encodeBuffer;
+
+    struct PendingBatch {
+        std::shared_ptr<const std::string> _process;
+        std::string _spans;
+        int _numSpans;
+        int64_t _size;
+    };
+
+    int64_t _retryBufferSize;
+    Clock::duration _minBackoff;
+    Clock::duration _maxBackoff;
+    // Full batches waiting for a multi-packet send, or for a retry.
+    std::deque<PendingBatch> _batches;
+    int64_t _batchBytes;
+    std::vector<utils::Transport::SerializedBatch> _sendList;
+    int _failures;
+    Clock::time_point _nextAttempt;
+    std::mt19937 _randomNumberGenerator;
+    // Failures not yet reported by an exception.
+    int _numFailed;
+    bool _errorPending;
+    std::string _error;
+};
+
+}  // namespace jaegertracing
+
+#endif  //JAEGERTRACING_THRIFTSENDER_H
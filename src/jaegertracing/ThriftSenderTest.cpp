@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <thread>
+
 #include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h>
 
 #include "jaegertracing/Tracer.h"
 #include "jaegertracing/ThriftSender.h"
@@ -37,7 +41,16 @@ class MockUDPSender : public utils::UDPTransporter {
     }
 
   private:
-    void emitBatch(const thrift::Batch& batch) override
+    void emitBatch(const thrift::Batch& batch) override { fail(); }
+
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override
+    {
+        fail();
+    }
+
+    void fail()
     {
         switch (_type) {
         case ExceptionType::kSystemError:
@@ -64,6 +77,50 @@ class MockThriftSender : public ThriftSender {
     }
 };
 
+class FlakyTransport : public utils::Transport {
+  public:
+    FlakyTransport()
+        : Transport(65000)
+        , _targetPacketSize(65000)
+        , _fail(false)
+        , _numAttempts(0)
+        , _numSpans(0)
+    {
+    }
+
+    void emitBatch(const thrift::Batch& batch) override
+    {
+        ++_numAttempts;
+        if (_fail) {
+            throw std::runtime_error("agent unavailable");
+        }
+        _numSpans += static_cast<int>(batch.spans.size());
+    }
+
+    std::unique_ptr<apache::thrift::protocol::TProtocolFactory>
+    protocolFactory() const override
+    {
+        return std::unique_ptr<apache::thrift::protocol::TProtocolFactory>(
+            new apache::thrift::protocol::TCompactProtocolFactory());
+    }
+
+    int targetPacketSize() const override { return _targetPacketSize; }
+
+    void setTargetPacketSize(int size) { _targetPacketSize = size; }
+
+    void setFail(bool fail) { _fail = fail; }
+
+    int numAttempts() const { return _numAttempts; }
+
+    int numSpans() const { return _numSpans; }
+
+  private:
+    int _targetPacketSize;
+    bool _fail;
+    int _numAttempts;
+    int _numSpans;
+};
+
 }  // anonymous namespace
 
 TEST(ThriftSender, testManyMessages)
@@ -85,6 +142,77 @@ TEST(ThriftSender, testManyMessages)
     }
 }
 
+TEST(ThriftSender, testSerializedSpans)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+
+    ThriftSender sender(handle->_mockAgent->spanServerClient());
+    constexpr auto kNumSpans = 10;
+    for (auto i = 0; i < kNumSpans; ++i) {
+        Span span(tracer);
+        span.SetOperationName("span-" + std::to_string(i));
+        span.SetTag("index", i);
+        if (i % 2 == 0) {
+            sender.append(span);
+        }
+        else {
+            sender.appendSerialized(sender.serialize(
+                std::unique_ptr<Span>(new Span(span))));
+        }
+    }
+    ASSERT_EQ(kNumSpans, sender.flush());
+
+    for (auto i = 0; i < 100 && handle->_mockAgent->batches().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto batches = handle->_mockAgent->batches();
+    ASSERT_EQ(1, static_cast<int>(batches.size()));
+    ASSERT_EQ(tracer->serviceName(), batches[0].process.serviceName);
+    ASSERT_EQ(kNumSpans, static_cast<int>(batches[0].spans.size()));
+    for (auto i = 0; i < kNumSpans; ++i) {
+        const auto& span = batches[0].spans[i];
+        ASSERT_EQ("span-" + std::to_string(i), span.operationName);
+        ASSERT_EQ(1, static_cast<int>(span.tags.size()));
+        ASSERT_EQ(i, span.tags[0].vLong);
+    }
+}
+
+TEST(ThriftSender, testProcessChange)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+    const auto otherTracer = std::static_pointer_cast<const Tracer>(
+        Tracer::make("other-service",
+                     Config(false,
+                            false,
+                            samplers::Config("const", 1),
+                            reporters::Config(),
+                            propagation::HeadersConfig(),
+                            baggage::RestrictionsConfig()),
+                     logging::nullLogger()));
+
+    ThriftSender sender(handle->_mockAgent->spanServerClient());
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    // Spans of the first process are sent before the process changes.
+    ASSERT_EQ(2, sender.append(Span(otherTracer)));
+    ASSERT_EQ(1, sender.flush());
+
+    for (auto i = 0; i < 100 && handle->_mockAgent->batches().size() < 2;
+         ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto batches = handle->_mockAgent->batches();
+    ASSERT_EQ(2, static_cast<int>(batches.size()));
+    ASSERT_EQ(tracer->serviceName(), batches[0].process.serviceName);
+    ASSERT_EQ(2, static_cast<int>(batches[0].spans.size()));
+    ASSERT_EQ("other-service", batches[1].process.serviceName);
+    ASSERT_EQ(1, static_cast<int>(batches[1].spans.size()));
+}
+
 TEST(ThriftSender, testExceptions)
 {
     const auto handle = testutils::TracerUtil::installGlobalTracer();
@@ -107,3 +235,145 @@ TEST(ThriftSender, testExceptions)
 }
 
 }  // namespace jaegertracing
+
+TEST(ThriftSender, testRetryBuffer)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+
+    auto* transport = new FlakyTransport();
+    ThriftSender sender(std::unique_ptr<utils::Transport>(transport),
+                        1024 * 1024,
+                        std::chrono::milliseconds(10),
+                        std::chrono::milliseconds(10));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+
+    transport->setFail(true);
+    try {
+        sender.flush();
+        FAIL() << "Expected Sender::Exception";
+    } catch (const Sender::Exception& ex) {
+        // The batch is kept for another attempt.
+        ASSERT_EQ(0, ex.numFailed());
+    }
+
+    transport->setFail(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(2, sender.flush());
+    ASSERT_EQ(2, transport->numSpans());
+}
+
+TEST(ThriftSender, testTargetPacketSize)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+
+    auto* transport = new FlakyTransport();
+    ThriftSender sender(std::unique_ptr<utils::Transport>(transport),
+                        1024 * 1024,
+                        std::chrono::milliseconds(10),
+                        std::chrono::milliseconds(10));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+
+    // The send fails because the packet was too large for the network.
+    transport->setFail(true);
+    transport->setTargetPacketSize(64);
+    try {
+        sender.flush();
+        FAIL() << "Expected Sender::Exception";
+    } catch (const Sender::Exception& ex) {
+        // The batch would not fit in a packet again.
+        ASSERT_EQ(2, ex.numFailed());
+    }
+
+    transport->setFail(false);
+    transport->setTargetPacketSize(65000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(0, sender.flush());
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(1, sender.flush());
+    ASSERT_EQ(1, transport->numSpans());
+}
+
+TEST(ThriftSender, testNoRetryBuffer)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+
+    auto* transport = new FlakyTransport();
+    ThriftSender sender(std::unique_ptr<utils::Transport>(transport));
+    transport->setFail(true);
+    for (auto i = 0; i < ThriftSender::kCircuitBreakerThreshold + 1; ++i) {
+        ASSERT_EQ(0, sender.append(Span(tracer)));
+        try {
+            sender.flush();
+            FAIL() << "Expected Sender::Exception";
+        } catch (const Sender::Exception& ex) {
+            ASSERT_EQ(1, ex.numFailed());
+        }
+    }
+    // Every flush tried to send, with no backoff in between.
+    ASSERT_EQ(ThriftSender::kCircuitBreakerThreshold + 1,
+              transport->numAttempts());
+
+    // Nor is the circuit open once the agent is back.
+    transport->setFail(false);
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(1, sender.flush());
+    ASSERT_EQ(1, transport->numSpans());
+}
+
+TEST(ThriftSender, testCircuitBreaker)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<const Tracer>(opentracing::Tracer::Global());
+
+    // A retry buffer too small to keep any batch enables the backoff and
+    // the circuit breaker, while dropping each failed batch.
+    auto* transport = new FlakyTransport();
+    ThriftSender sender(std::unique_ptr<utils::Transport>(transport),
+                        1,
+                        std::chrono::milliseconds(50),
+                        std::chrono::milliseconds(50));
+    transport->setFail(true);
+    for (auto i = 0; i < ThriftSender::kCircuitBreakerThreshold; ++i) {
+        ASSERT_EQ(0, sender.append(Span(tracer)));
+        try {
+            sender.flush();
+            FAIL() << "Expected Sender::Exception";
+        } catch (const Sender::Exception& ex) {
+            ASSERT_EQ(1, ex.numFailed());
+        }
+        if (i + 1 < ThriftSender::kCircuitBreakerThreshold) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        }
+    }
+    ASSERT_EQ(ThriftSender::kCircuitBreakerThreshold,
+              transport->numAttempts());
+
+    // While the circuit is open, spans are dropped without being sent.
+    constexpr auto kNumDropped = 5;
+    for (auto i = 0; i < kNumDropped; ++i) {
+        ASSERT_EQ(0, sender.append(Span(tracer)));
+    }
+    try {
+        sender.flush();
+        FAIL() << "Expected Sender::Exception";
+    } catch (const Sender::Exception& ex) {
+        ASSERT_EQ(kNumDropped, ex.numFailed());
+    }
+    ASSERT_EQ(ThriftSender::kCircuitBreakerThreshold,
+              transport->numAttempts());
+
+    transport->setFail(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_EQ(0, sender.append(Span(tracer)));
+    ASSERT_EQ(1, sender.flush());
+    ASSERT_EQ(1, transport->numSpans());
+}
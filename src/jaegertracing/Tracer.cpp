@@ -18,6 +18,7 @@
 #include "jaegertracing/Tracer.h"
 #include "jaegertracing/Reference.h"
 #include "jaegertracing/TraceID.h"
+#include "jaegertracing/UnsampledSpan.h"
 #include "jaegertracing/propagation/JaegerPropagator.h"
 #include "jaegertracing/propagation/W3CPropagator.h"
 #include "jaegertracing/samplers/SamplingStatus.h"
@@ -58,11 +59,25 @@ TimePoints determineStartTimes(const opentracing::StartSpanOptions& options)
                            options.start_steady_timestamp);
 }
 
+bool hasSamplingPriority(
+    const std::vector<std::pair<std::string, opentracing::Value>>& tags)
+{
+    return std::any_of(
+        std::begin(tags),
+        std::end(tags),
+        [](const std::pair<std::string, opentracing::Value>& tag) {
+            return tag.first == "sampling.priority";
+        });
+}
+
 }  // anonymous namespace
 
 using StrMap = SpanContext::StrMap;
 
 constexpr int Tracer::kGen128BitOption;
+constexpr int Tracer::kLightweightUnsampledSpansOption;
+constexpr int Tracer::kSingleOwnerSpansOption;
+constexpr int Tracer::kDetachFinishedSpansOption;
 
 std::unique_ptr<opentracing::Span>
 Tracer::StartSpanWithOptions(string_view operationName,
@@ -133,6 +148,16 @@ Tracer::StartSpanWithOptions(string_view operationName,
         SteadyClock::time_point startTimeSteady;
         std::tie(startTimeSystem, startTimeSteady) =
             determineStartTimes(options);
+        if ((_options & kLightweightUnsampledSpansOption) != 0 &&
+            !ctx.isSampled() && !hasSamplingPriority(options.tags)) {
+            countStartedSpan(false, newTrace);
+            return std::unique_ptr<opentracing::Span>(
+                new UnsampledSpan(shared_from_this(),
+                                  ctx,
+                                  operationName,
+                                  startTimeSystem,
+                                  startTimeSteady));
+        }
         return startSpanInternal(ctx,
                                  operationName,
                                  startTimeSystem,
@@ -161,28 +186,42 @@ Tracer::startSpanInternal(const SpanContext& context,
                           const std::vector<Tag>& internalTags,
                           const std::vector<OpenTracingTag>& tags,
                           bool newTrace,
-                          const std::vector<Reference>& references) const
+                          const Span::References& references) const
 {
-    std::vector<Tag> spanTags;
+    auto buffers = _spanPool->acquire();
+    auto& spanTags = buffers._tags;
+    auto& arena = buffers._arena;
     spanTags.reserve(tags.size() + internalTags.size());
-    std::transform(
-        std::begin(tags),
-        std::end(tags),
-        std::back_inserter(spanTags),
-        [](const OpenTracingTag& tag) { return Tag(tag.first, tag.second); });
+    std::transform(std::begin(tags),
+                   std::end(tags),
+                   std::back_inserter(spanTags),
+                   [&arena](const OpenTracingTag& tag) {
+                       return Tag(tag.first, tag.second, arena);
+                   });
     spanTags.insert(
         std::end(spanTags), std::begin(internalTags), std::end(internalTags));
+    buffers._references.assign(std::begin(references), std::end(references));
 
+    const auto singleOwner = (_options & kSingleOwnerSpansOption) != 0;
     std::unique_ptr<Span> span(new Span(shared_from_this(),
                                         context,
                                         operationName,
                                         startTimeSystem,
                                         startTimeSteady,
-                                        spanTags,
-                                        references));
+                                        std::move(buffers._tags),
+                                        std::move(buffers._logs),
+                                        std::move(buffers._references),
+                                        std::move(arena),
+                                        singleOwner));
+
+    countStartedSpan(span->contextNoLock().isSampled(), newTrace);
+    return span;
+}
 
+void Tracer::countStartedSpan(bool sampled, bool newTrace) const
+{
     _metrics->spansStarted().inc(1);
-    if (span->context().isSampled()) {
+    if (sampled) {
         _metrics->spansSampled().inc(1);
         if (newTrace) {
             _metrics->tracesStartedSampled().inc(1);
@@ -194,8 +233,6 @@ Tracer::startSpanInternal(const SpanContext& context,
             _metrics->tracesStartedNotSampled().inc(1);
         }
     }
-
-    return span;
 }
 
 Tracer::AnalyzedReferences
@@ -30,6 +30,7 @@
 #include "jaegertracing/Constants.h"
 #include "jaegertracing/Logging.h"
 #include "jaegertracing/Span.h"
+#include "jaegertracing/SpanPool.h"
 #include "jaegertracing/Tag.h"
 #include "jaegertracing/baggage/BaggageSetter.h"
 #include "jaegertracing/baggage/RestrictionManager.h"
@@ -52,6 +53,16 @@ class Tracer : public opentracing::Tracer,
     using string_view = opentracing::string_view;
 
     static constexpr auto kGen128BitOption = 1;
+    // Start an UnsampledSpan rather than a Span for traces that are not
+    // sampled, unless a sampling.priority start tag asks for sampling.
+    static constexpr auto kLightweightUnsampledSpansOption = 2;
+    // Start spans that take no locks, for callers that only use each span
+    // from the thread that started it.
+    static constexpr auto kSingleOwnerSpansOption = 4;
+    // Move the data of finished sampled spans to the reporter instead of
+    // copying it; the finished span then no longer returns its tags, logs
+    // and references.
+    static constexpr auto kDetachFinishedSpansOption = 8;
 
     static std::shared_ptr<opentracing::Tracer> make(const Config& config)
     {
@@ -82,7 +93,19 @@ class Tracer : public opentracing::Tracer,
          const std::shared_ptr<logging::Logger>& logger,
          metrics::StatsFactory& statsFactory)
     {
-        return make(serviceName, config, logger, statsFactory, config.traceId128Bit() ? kGen128BitOption : 0);
+        return make(serviceName,
+                    config,
+                    logger,
+                    statsFactory,
+                    (config.traceId128Bit() ? kGen128BitOption : 0) |
+                        (config.lightweightUnsampledSpans()
+                             ? kLightweightUnsampledSpansOption
+                             : 0) |
+                        (config.singleOwnerSpans() ? kSingleOwnerSpansOption
+                                                   : 0) |
+                        (config.detachFinishedSpans()
+                             ? kDetachFinishedSpansOption
+                             : 0));
     }
     static std::shared_ptr<opentracing::Tracer>
     make(const std::string& serviceName,
@@ -192,6 +215,8 @@ class Tracer : public opentracing::Tracer,
         return _baggageSetter;
     }
 
+    SpanPool& spanPool() const { return *_spanPool; }
+
     void reportSpan(const Span& span) const
     {
         _metrics->spansFinished().inc(1);
@@ -200,6 +225,21 @@ class Tracer : public opentracing::Tracer,
         }
     }
 
+    bool detachFinishedSpans() const
+    {
+        return (_options & kDetachFinishedSpansOption) != 0;
+    }
+
+    // Takes the finished span's data without copying it. `span` is null for
+    // spans that were not sampled, which are only counted.
+    void reportSpan(std::unique_ptr<Span>&& span) const
+    {
+        _metrics->spansFinished().inc(1);
+        if (span && span->contextNoLock().isSampled()) {
+            _reporter->report(std::move(span));
+        }
+    }
+
   private:
     using TextMapPropagator =
         propagation::Propagator<const opentracing::TextMapReader&,
@@ -231,6 +271,7 @@ class Tracer : public opentracing::Tracer,
         , _restrictionManager(new baggage::DefaultRestrictionManager(0))
         , _baggageSetter(*_restrictionManager, *_metrics)
         , _options(options)
+        , _spanPool(new SpanPool(*_metrics))
     {
         _tags.push_back(Tag(kJaegerClientVersionTagKey, kJaegerClientVersion));
 
@@ -273,7 +314,9 @@ class Tracer : public opentracing::Tracer,
                       const std::vector<Tag>& internalTags,
                       const std::vector<OpenTracingTag>& tags,
                       bool newTrace,
-                      const std::vector<Reference>& references) const;
+                      const Span::References& references) const;
+
+    void countStartedSpan(bool sampled, bool newTrace) const;
 
     using OpenTracingRef = std::pair<opentracing::SpanReferenceType,
                                      const opentracing::SpanContext*>;
@@ -288,7 +331,7 @@ class Tracer : public opentracing::Tracer,
 
         const SpanContext* _parent;
         const SpanContext* _self;
-        std::vector<Reference> _references;
+        Span::References _references;
     };
 
     AnalyzedReferences
@@ -309,6 +352,7 @@ class Tracer : public opentracing::Tracer,
     std::unique_ptr<baggage::RestrictionManager> _restrictionManager;
     baggage::BaggageSetter _baggageSetter;
     int _options;
+    std::unique_ptr<SpanPool> _spanPool;
 };
 
 
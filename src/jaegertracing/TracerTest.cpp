@@ -26,6 +26,7 @@
 #include "jaegertracing/propagation/HeadersConfig.h"
 #include "jaegertracing/reporters/Config.h"
 #include "jaegertracing/samplers/Config.h"
+#include "jaegertracing/testutils/MockAgent.h"
 #include "jaegertracing/testutils/TracerUtil.h"
 #include <algorithm>
 #include <chrono>
@@ -42,6 +43,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -624,4 +626,128 @@ TEST(Tracer, testTracerWithTraceId128Bit)
     tracer->close();
 }
 
+TEST(Tracer, testFinishedSpanKeepsItsData)
+{
+    const auto handle = testutils::TracerUtil::installGlobalTracer();
+    const auto tracer =
+        std::static_pointer_cast<Tracer>(opentracing::Tracer::Global());
+    ASSERT_FALSE(tracer->detachFinishedSpans());
+
+    std::unique_ptr<Span> span(static_cast<Span*>(
+        tracer->StartSpan("test-finished-span").release()));
+    ASSERT_TRUE(static_cast<bool>(span));
+    span->SetTag("tag-key", "tag-value");
+    span->Finish();
+
+    const auto tags = span->tags();
+    ASSERT_EQ(1, static_cast<int>(tags.size()));
+    ASSERT_EQ("tag-key", std::string(tags[0].key()));
+    tracer->Close();
+    opentracing::Tracer::InitGlobal(opentracing::MakeNoopTracer());
+}
+
+TEST(Tracer, testFinishedSpanDataIsHandedToReporter)
+{
+    const auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+    Config config(
+        false,
+        false,
+        samplers::Config("const",
+                         1,
+                         "",
+                         0,
+                         samplers::Config::Clock::duration()),
+        reporters::Config(0,
+                          std::chrono::milliseconds(10),
+                          false,
+                          mockAgent->spanServerAddress().authority()),
+        propagation::HeadersConfig(),
+        baggage::RestrictionsConfig(),
+        "test-service",
+        std::vector<Tag>(),
+        propagation::Format::JAEGER,
+        false,
+        false,
+        true);
+    const auto tracer = std::static_pointer_cast<Tracer>(
+        Tracer::make("test-service", config, logging::nullLogger()));
+    ASSERT_TRUE(tracer->detachFinishedSpans());
+
+    std::unique_ptr<Span> span(static_cast<Span*>(
+        tracer->StartSpan("test-detached-span").release()));
+    ASSERT_TRUE(static_cast<bool>(span));
+    span->SetTag("tag-key", "tag-value");
+    span->Finish();
+
+    // The tags now belong to the reporter; the span keeps its identity.
+    ASSERT_TRUE(span->tags().empty());
+    ASSERT_EQ("test-detached-span", span->operationName());
+    ASSERT_TRUE(span->context().isValid());
+    tracer->Close();
+
+    std::vector<thrift::Batch> batches;
+    constexpr auto kNumTries = 100;
+    for (auto i = 0; i < kNumTries && batches.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        batches = mockAgent->batches();
+    }
+    ASSERT_EQ(1, static_cast<int>(batches.size()));
+    ASSERT_EQ(1, static_cast<int>(batches[0].spans.size()));
+    const auto& thriftSpan = batches[0].spans[0];
+    ASSERT_EQ("test-detached-span", thriftSpan.operationName);
+    ASSERT_EQ(1, static_cast<int>(thriftSpan.tags.size()));
+    ASSERT_EQ("tag-key", thriftSpan.tags[0].key);
+    ASSERT_EQ("tag-value", thriftSpan.tags[0].vStr);
+}
+
+TEST(Tracer, testSingleOwnerSpans)
+{
+    const auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+    Config config(
+        false,
+        false,
+        samplers::Config("const",
+                         1,
+                         "",
+                         0,
+                         samplers::Config::Clock::duration()),
+        reporters::Config(0,
+                          std::chrono::milliseconds(10),
+                          false,
+                          mockAgent->spanServerAddress().authority()),
+        propagation::HeadersConfig(),
+        baggage::RestrictionsConfig(),
+        "test-service",
+        std::vector<Tag>(),
+        propagation::Format::JAEGER,
+        false,
+        true);
+    const auto tracer = std::static_pointer_cast<Tracer>(
+        Tracer::make("test-service", config, logging::nullLogger()));
+
+    {
+        std::unique_ptr<Span> span(static_cast<Span*>(
+            tracer->StartSpan("test-single-owner").release()));
+        ASSERT_TRUE(span->singleOwner());
+        span->SetTag("tag-key", "tag-value");
+        span->Log({ { "event", "test" } });
+        span->Finish();
+    }
+    tracer->Close();
+
+    std::vector<thrift::Batch> batches;
+    constexpr auto kNumTries = 100;
+    for (auto i = 0; i < kNumTries && batches.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        batches = mockAgent->batches();
+    }
+    ASSERT_EQ(1, static_cast<int>(batches.size()));
+    ASSERT_EQ(1, static_cast<int>(batches[0].spans.size()));
+    const auto& thriftSpan = batches[0].spans[0];
+    ASSERT_EQ("test-single-owner", thriftSpan.operationName);
+    ASSERT_EQ(1, static_cast<int>(thriftSpan.logs.size()));
+}
+
 }  // namespace jaegertracing
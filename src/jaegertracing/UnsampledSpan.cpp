@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/UnsampledSpan.h"
+
+#include <vector>
+
+#include "jaegertracing/Tag.h"
+#include "jaegertracing/Tracer.h"
+
+namespace jaegertracing {
+
+UnsampledSpan::~UnsampledSpan()
+{
+    Finish();
+    delete _span.load();
+}
+
+void UnsampledSpan::FinishWithOptions(
+    const opentracing::FinishSpanOptions& finishSpanOptions) noexcept
+{
+    jaegertracing::Span* span = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        span = _span.load();
+        if (!span) {
+            if (_finished) {
+                return;
+            }
+            _finished = true;
+        }
+    }
+
+    if (span) {
+        span->FinishWithOptions(finishSpanOptions);
+    }
+    else if (_tracer) {
+        // Only counted.
+        _tracer->reportSpan(std::unique_ptr<jaegertracing::Span>());
+    }
+}
+
+void UnsampledSpan::SetOperationName(opentracing::string_view name) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto* span = _span.load()) {
+        span->SetOperationName(name);
+    }
+    else if (!_finished) {
+        _operationName = name;
+    }
+}
+
+void UnsampledSpan::SetTag(opentracing::string_view key,
+                           const opentracing::Value& value) noexcept
+{
+    if (key == "sampling.priority" && !_span.load() &&
+        jaegertracing::Span::samplingPriority(value)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        promoteNoLock();
+    }
+    // Sets the sampled and debug flags of a span just promoted.
+    if (auto* span = _span.load()) {
+        span->SetTag(key, value);
+    }
+}
+
+void UnsampledSpan::SetBaggageItem(opentracing::string_view restrictedKey,
+                                   opentracing::string_view value) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto* span = _span.load()) {
+        span->SetBaggageItem(restrictedKey, value);
+        return;
+    }
+    auto baggage = _context.baggage();
+    _tracer->baggageSetter().setBaggage(
+        *this,
+        baggage,
+        restrictedKey,
+        value,
+        [](std::vector<Tag>::const_iterator, std::vector<Tag>::const_iterator) {
+            // Baggage is only logged to sampled spans.
+        });
+    _context = _context.withBaggage(baggage);
+}
+
+std::string
+UnsampledSpan::BaggageItem(opentracing::string_view restrictedKey) const
+    noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto* span = _span.load()) {
+        return span->BaggageItem(restrictedKey);
+    }
+    auto itr = _context.baggage().find(restrictedKey);
+    return (itr == std::end(_context.baggage())) ? std::string()
+                                                 : itr->second;
+}
+
+const SpanContext& UnsampledSpan::context() const noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto* span = _span.load()) {
+        return span->context();
+    }
+    return _context;
+}
+
+const opentracing::Tracer& UnsampledSpan::tracer() const noexcept
+{
+    return *_tracer;
+}
+
+std::string UnsampledSpan::serviceNameNoLock() const noexcept
+{
+    return _tracer->serviceName();
+}
+
+void UnsampledSpan::promoteNoLock()
+{
+    if (_finished || _span.load()) {
+        return;
+    }
+    _span.store(new jaegertracing::Span(_tracer,
+                                        _context,
+                                        _operationName,
+                                        _startTimeSystem,
+                                        _startTimeSteady));
+}
+
+}  // namespace jaegertracing
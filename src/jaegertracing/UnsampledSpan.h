@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_UNSAMPLEDSPAN_H
+#define JAEGERTRACING_UNSAMPLEDSPAN_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opentracing/span.h>
+
+#include "jaegertracing/Span.h"
+#include "jaegertracing/SpanContext.h"
+
+namespace jaegertracing {
+
+class Tracer;
+
+// Stands in for a Span of a trace that is not sampled, for tracers made with
+// Tracer::kLightweightUnsampledSpansOption. Carries the context, so that the
+// trace still propagates, but drops tags and logs without storing them and
+// reports nothing when finished. Setting sampling.priority promotes it to a
+// Span that records from then on and is reported when finished; tags set
+// before that, and references other than the parent, are not part of it.
+class UnsampledSpan : public opentracing::Span {
+  public:
+    using SteadyClock = opentracing::SteadyClock;
+    using SystemClock = opentracing::SystemClock;
+
+    UnsampledSpan(const std::shared_ptr<const Tracer>& tracer,
+                  const SpanContext& context,
+                  opentracing::string_view operationName,
+                  const SystemClock::time_point& startTimeSystem,
+                  const SteadyClock::time_point& startTimeSteady)
+        : _tracer(tracer)
+        , _context(context)
+        , _operationName(operationName)
+        , _startTimeSystem(startTimeSystem)
+        , _startTimeSteady(startTimeSteady)
+        , _finished(false)
+        , _span(nullptr)
+        , _mutex()
+    {
+    }
+
+    UnsampledSpan(const UnsampledSpan&) = delete;
+
+    UnsampledSpan& operator=(const UnsampledSpan&) = delete;
+
+    ~UnsampledSpan();
+
+    // The span this one was promoted to, or null.
+    const jaegertracing::Span* promoted() const { return _span.load(); }
+
+    void FinishWithOptions(const opentracing::FinishSpanOptions&
+                               finishSpanOptions) noexcept override;
+
+    void SetOperationName(opentracing::string_view name) noexcept override;
+
+    void SetTag(opentracing::string_view key,
+                const opentracing::Value& value) noexcept override;
+
+    void SetBaggageItem(opentracing::string_view restrictedKey,
+                        opentracing::string_view value) noexcept override;
+
+    std::string BaggageItem(opentracing::string_view restrictedKey) const
+        noexcept override;
+
+    void Log(opentracing::SystemTime timestamp,
+             std::initializer_list<
+                 std::pair<opentracing::string_view, opentracing::Value>>
+                 fieldPairs) noexcept override
+    {
+        if (auto* span = _span.load()) {
+            span->Log(timestamp, fieldPairs);
+        }
+    }
+
+    void Log(opentracing::SystemTime timestamp,
+             const std::vector<
+                 std::pair<opentracing::string_view, opentracing::Value>>&
+                 fieldPairs) noexcept override
+    {
+        if (auto* span = _span.load()) {
+            span->Log(timestamp, fieldPairs);
+        }
+    }
+
+    void Log(std::initializer_list<
+             std::pair<opentracing::string_view, opentracing::Value>>
+                 fieldPairs) noexcept override
+    {
+        if (auto* span = _span.load()) {
+            span->Log(fieldPairs);
+        }
+    }
+
+    const SpanContext& context() const noexcept override;
+
+    const opentracing::Tracer& tracer() const noexcept override;
+
+    // For the baggage setter, which is called with the mutex held.
+    const SpanContext& contextNoLock() const noexcept { return _context; }
+
+    std::string serviceNameNoLock() const noexcept;
+
+  private:
+    // Replaces this span with a Span, unless finished.
+    void promoteNoLock();
+
+    std::shared_ptr<const Tracer> _tracer;
+    SpanContext _context;
+    std::string _operationName;
+    SystemClock::time_point _startTimeSystem;
+    SteadyClock::time_point _startTimeSteady;
+    bool _finished;
+    // Set once, when promoted. Owned by this span.
+    std::atomic<jaegertracing::Span*> _span;
+    // Guards everything but _span, which SetTag() and Log() load without
+    // locking.
+    mutable std::mutex _mutex;
+};
+
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UNSAMPLEDSPAN_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/UnsampledSpan.h"
+#include "jaegertracing/Config.h"
+#include "jaegertracing/Logging.h"
+#include "jaegertracing/Tracer.h"
+#include "jaegertracing/baggage/RestrictionsConfig.h"
+#include "jaegertracing/propagation/HeadersConfig.h"
+#include "jaegertracing/reporters/Config.h"
+#include "jaegertracing/samplers/Config.h"
+#include "jaegertracing/testutils/MockAgent.h"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jaegertracing {
+namespace {
+
+std::shared_ptr<Tracer> makeTracer(const testutils::MockAgent& mockAgent)
+{
+    Config config(
+        false,
+        false,
+        samplers::Config("const",
+                         0,
+                         "",
+                         0,
+                         samplers::Config::Clock::duration()),
+        reporters::Config(0,
+                          std::chrono::milliseconds(10),
+                          false,
+                          mockAgent.spanServerAddress().authority()),
+        propagation::HeadersConfig(),
+        baggage::RestrictionsConfig(),
+        "test-service",
+        std::vector<Tag>(),
+        propagation::Format::JAEGER,
+        true);
+    return std::static_pointer_cast<Tracer>(
+        Tracer::make("test-service", config, logging::nullLogger()));
+}
+
+}  // anonymous namespace
+
+TEST(UnsampledSpan, testPropagatesContext)
+{
+    const auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+    const auto tracer = makeTracer(*mockAgent);
+
+    auto parent = tracer->StartSpan("parent");
+    auto* unsampled = dynamic_cast<UnsampledSpan*>(parent.get());
+    ASSERT_NE(nullptr, unsampled);
+    parent->SetTag("tag", "dropped");
+    parent->Log({ { "event", "dropped" } });
+    parent->SetBaggageItem("key", "value");
+    ASSERT_EQ("value", parent->BaggageItem("key"));
+
+    auto child = tracer->StartSpan(
+        "child", { opentracing::ChildOf(&parent->context()) });
+    ASSERT_NE(nullptr, dynamic_cast<UnsampledSpan*>(child.get()));
+    ASSERT_EQ("value", child->BaggageItem("key"));
+    const auto& parentContext =
+        static_cast<const SpanContext&>(parent->context());
+    const auto& childContext =
+        static_cast<const SpanContext&>(child->context());
+    ASSERT_EQ(parentContext.traceID(), childContext.traceID());
+    ASSERT_EQ(parentContext.spanID(), childContext.parentID());
+    ASSERT_FALSE(childContext.isSampled());
+    child->Finish();
+    parent->Finish();
+    ASSERT_EQ(nullptr, unsampled->promoted());
+    tracer->Close();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_TRUE(mockAgent->batches().empty());
+}
+
+TEST(UnsampledSpan, testSamplingPriorityPromotes)
+{
+    const auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+    const auto tracer = makeTracer(*mockAgent);
+
+    auto span = tracer->StartSpan("operation");
+    auto* unsampled = dynamic_cast<UnsampledSpan*>(span.get());
+    ASSERT_NE(nullptr, unsampled);
+    span->SetTag("before", "dropped");
+    span->SetTag("sampling.priority", 1);
+    ASSERT_NE(nullptr, unsampled->promoted());
+    const auto& context = static_cast<const SpanContext&>(span->context());
+    ASSERT_TRUE(context.isSampled());
+    ASSERT_TRUE(context.isDebug());
+    span->SetTag("after", "kept");
+    span->Finish();
+    tracer->Close();
+
+    std::vector<thrift::Batch> batches;
+    constexpr auto kNumTries = 100;
+    for (auto i = 0; i < kNumTries && batches.empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        batches = mockAgent->batches();
+    }
+    ASSERT_EQ(1, static_cast<int>(batches.size()));
+    const auto& spans = batches[0].spans;
+    ASSERT_EQ(1, static_cast<int>(spans.size()));
+    ASSERT_EQ("operation", spans[0].operationName);
+    const auto& tags = spans[0].tags;
+    ASSERT_TRUE(std::any_of(std::begin(tags),
+                            std::end(tags),
+                            [](const thrift::Tag& tag) {
+                                return tag.key == "after";
+                            }));
+    ASSERT_FALSE(std::any_of(std::begin(tags),
+                             std::end(tags),
+                             [](const thrift::Tag& tag) {
+                                 return tag.key == "before";
+                             }));
+}
+
+TEST(UnsampledSpan, testSamplingPriorityStartTag)
+{
+    const auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+    const auto tracer = makeTracer(*mockAgent);
+
+    auto span = tracer->StartSpan(
+        "operation", { opentracing::SetTag("sampling.priority", 1) });
+    ASSERT_NE(nullptr, dynamic_cast<Span*>(span.get()));
+    ASSERT_TRUE(static_cast<const SpanContext&>(span->context()).isSampled());
+    span->Finish();
+    tracer->Close();
+}
+
+}  // namespace jaegertracing
@@ -34,8 +34,9 @@ class BaggageSetter {
     {
     }
 
-    template <typename LoggingFunction>
-    void setBaggage(Span& span,
+    // `span` is a Span or an UnsampledSpan.
+    template <typename SpanType, typename LoggingFunction>
+    void setBaggage(SpanType& span,
                     SpanContext::StrMap& baggage,
                     const std::string& key,
                     std::string value,
@@ -82,8 +83,8 @@ class BaggageSetter {
     }
 
   private:
-    template <typename LoggingFunction>
-    void logFields(const Span& span,
+    template <typename SpanType, typename LoggingFunction>
+    void logFields(const SpanType& span,
                    const std::string& key,
                    const std::string& value,
                    const std::string& prevItem,
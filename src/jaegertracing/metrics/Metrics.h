@@ -63,13 +63,35 @@ class Metrics {
         , _spansNotSampled(factory.createCounter(
               "jaeger.spans", { { "group", "sampling" }, { "sampled", "n" } }))
         , _decodingErrors(factory.createCounter("jaeger.decoding-errors"))
+        , _spanPoolHits(factory.createCounter("jaeger.span-pool",
+                                              { { "result", "hit" } }))
+        , _spanPoolMisses(factory.createCounter("jaeger.span-pool",
+                                                { { "result", "miss" } }))
+        , _spanPoolRefills(
+              factory.createCounter("jaeger.span-pool-refills"))
         , _reporterSuccess(factory.createCounter("jaeger.reporter-spans",
                                                  { { "state", "success" } }))
         , _reporterFailure(factory.createCounter("jaeger.reporter-spans",
                                                  { { "state", "failure" } }))
         , _reporterDropped(factory.createCounter("jaeger.reporter-spans",
                                                  { { "state", "dropped" } }))
+        , _reporterDroppedQueueFull(factory.createCounter(
+              "jaeger.reporter-dropped", { { "reason", "queue-full" } }))
+        , _reporterDroppedEvicted(factory.createCounter(
+              "jaeger.reporter-dropped", { { "reason", "evicted" } }))
+        , _reporterDroppedTimeout(factory.createCounter(
+              "jaeger.reporter-dropped", { { "reason", "timeout" } }))
+        , _reporterDroppedPriority(factory.createCounter(
+              "jaeger.reporter-dropped", { { "reason", "priority" } }))
         , _reporterQueueLength(factory.createGauge("jaeger.reporter-queue"))
+        , _reporterQueueBytes(
+              factory.createGauge("jaeger.reporter-queue-bytes"))
+        , _reporterPacketSize(
+              factory.createGauge("jaeger.reporter-packet-size"))
+        , _reporterBytesUncompressed(factory.createCounter(
+              "jaeger.reporter-bytes", { { "state", "uncompressed" } }))
+        , _reporterBytesCompressed(factory.createCounter(
+              "jaeger.reporter-bytes", { { "state", "compressed" } }))
         , _samplerRetrieved(factory.createCounter("jaeger.sampler",
                                                   { { "state", "retrieved" } }))
         , _samplerUpdated(factory.createCounter("jaeger.sampler",
@@ -131,6 +153,20 @@ class Metrics {
 
     Counter& decodingErrors() { return *_decodingErrors; }
 
+    // Spans started with and without vectors recycled from earlier spans.
+    const Counter& spanPoolHits() const { return *_spanPoolHits; }
+
+    Counter& spanPoolHits() { return *_spanPoolHits; }
+
+    const Counter& spanPoolMisses() const { return *_spanPoolMisses; }
+
+    Counter& spanPoolMisses() { return *_spanPoolMisses; }
+
+    // Times a thread's empty freelist locked the pool's shared list.
+    const Counter& spanPoolRefills() const { return *_spanPoolRefills; }
+
+    Counter& spanPoolRefills() { return *_spanPoolRefills; }
+
     const Counter& reporterSuccess() const { return *_reporterSuccess; }
 
     Counter& reporterSuccess() { return *_reporterSuccess; }
@@ -143,10 +179,67 @@ class Metrics {
 
     Counter& reporterDropped() { return *_reporterDropped; }
 
+    // Breakdown of reporterDropped() by cause: the queue was full under the
+    // drop-newest policy, a queued span was evicted under drop-oldest, a
+    // blocked report timed out, or a priority span could not be queued.
+    const Counter& reporterDroppedQueueFull() const
+    {
+        return *_reporterDroppedQueueFull;
+    }
+
+    Counter& reporterDroppedQueueFull() { return *_reporterDroppedQueueFull; }
+
+    const Counter& reporterDroppedEvicted() const
+    {
+        return *_reporterDroppedEvicted;
+    }
+
+    Counter& reporterDroppedEvicted() { return *_reporterDroppedEvicted; }
+
+    const Counter& reporterDroppedTimeout() const
+    {
+        return *_reporterDroppedTimeout;
+    }
+
+    Counter& reporterDroppedTimeout() { return *_reporterDroppedTimeout; }
+
+    const Counter& reporterDroppedPriority() const
+    {
+        return *_reporterDroppedPriority;
+    }
+
+    Counter& reporterDroppedPriority() { return *_reporterDroppedPriority; }
+
     const Gauge& reporterQueueLength() const { return *_reporterQueueLength; }
 
     Gauge& reporterQueueLength() { return *_reporterQueueLength; }
 
+    const Gauge& reporterQueueBytes() const { return *_reporterQueueBytes; }
+
+    Gauge& reporterQueueBytes() { return *_reporterQueueBytes; }
+
+    // Size the UDP transport currently keeps its packets to; lower than
+    // the configured maximum after sends failed for packets too large.
+    const Gauge& reporterPacketSize() const { return *_reporterPacketSize; }
+
+    Gauge& reporterPacketSize() { return *_reporterPacketSize; }
+
+    // Bytes of HTTP request bodies before and after compression; their
+    // ratio shows what compression saves.
+    const Counter& reporterBytesUncompressed() const
+    {
+        return *_reporterBytesUncompressed;
+    }
+
+    Counter& reporterBytesUncompressed() { return *_reporterBytesUncompressed; }
+
+    const Counter& reporterBytesCompressed() const
+    {
+        return *_reporterBytesCompressed;
+    }
+
+    Counter& reporterBytesCompressed() { return *_reporterBytesCompressed; }
+
     const Counter& samplerRetrieved() const { return *_samplerRetrieved; }
 
     Counter& samplerRetrieved() { return *_samplerRetrieved; }
@@ -221,10 +314,21 @@ class Metrics {
     std::unique_ptr<Counter> _spansSampled;
     std::unique_ptr<Counter> _spansNotSampled;
     std::unique_ptr<Counter> _decodingErrors;
+    std::unique_ptr<Counter> _spanPoolHits;
+    std::unique_ptr<Counter> _spanPoolMisses;
+    std::unique_ptr<Counter> _spanPoolRefills;
     std::unique_ptr<Counter> _reporterSuccess;
     std::unique_ptr<Counter> _reporterFailure;
     std::unique_ptr<Counter> _reporterDropped;
+    std::unique_ptr<Counter> _reporterDroppedQueueFull;
+    std::unique_ptr<Counter> _reporterDroppedEvicted;
+    std::unique_ptr<Counter> _reporterDroppedTimeout;
+    std::unique_ptr<Counter> _reporterDroppedPriority;
     std::unique_ptr<Gauge> _reporterQueueLength;
+    std::unique_ptr<Gauge> _reporterQueueBytes;
+    std::unique_ptr<Gauge> _reporterPacketSize;
+    std::unique_ptr<Counter> _reporterBytesUncompressed;
+    std::unique_ptr<Counter> _reporterBytesCompressed;
     std::unique_ptr<Counter> _samplerRetrieved;
     std::unique_ptr<Counter> _samplerUpdated;
     std::unique_ptr<Counter> _samplerUpdateFailure;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/net/http/ConnectionPool.h"
+
+namespace jaegertracing {
+namespace net {
+namespace http {
+
+constexpr int ConnectionPool::kDefaultMaxIdleConnections;
+
+ConnectionPool::ConnectionPool(const IPAddress& serverAddr,
+                               int maxIdleConnections)
+    : _serverAddr(serverAddr)
+    , _maxIdleConnections(maxIdleConnections > 0 ? maxIdleConnections : 1)
+    , _mutex()
+    , _idle()
+{
+}
+
+std::unique_ptr<ConnectionPool::Connection> ConnectionPool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_idle.empty()) {
+            auto connection = std::move(_idle.back());
+            _idle.pop_back();
+            return connection;
+        }
+    }
+    return connect();
+}
+
+std::unique_ptr<ConnectionPool::Connection> ConnectionPool::connect()
+{
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->_socket.open(AF_INET, SOCK_STREAM);
+    connection->_socket.connect(_serverAddr);
+    connection->_reused = false;
+    return connection;
+}
+
+void ConnectionPool::release(std::unique_ptr<Connection>&& connection)
+{
+    connection->_reused = true;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_idle.size() < _maxIdleConnections) {
+        _idle.push_back(std::move(connection));
+    }
+}
+
+void ConnectionPool::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _idle.clear();
+}
+
+}  // namespace http
+}  // namespace net
+}  // namespace jaegertracing
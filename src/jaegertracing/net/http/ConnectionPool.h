@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_NET_HTTP_CONNECTIONPOOL_H
+#define JAEGERTRACING_NET_HTTP_CONNECTIONPOOL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "jaegertracing/net/IPAddress.h"
+#include "jaegertracing/net/Socket.h"
+
+namespace jaegertracing {
+namespace net {
+namespace http {
+
+// Keeps idle keep-alive connections to one server so that requests do not
+// pay for a handshake each. Connections are made on demand, so a server
+// that restarts is simply connected to again. Safe to share between
+// threads, each request holding its connection exclusively.
+class ConnectionPool {
+  public:
+    struct Connection {
+        Socket _socket;
+        // Bytes received past the last response.
+        std::string _pending;
+        // Whether the connection already carried a request, in which case
+        // the server may have closed it in the meantime.
+        bool _reused;
+    };
+
+    static constexpr auto kDefaultMaxIdleConnections = 2;
+
+    explicit ConnectionPool(
+        const IPAddress& serverAddr,
+        int maxIdleConnections = kDefaultMaxIdleConnections);
+
+    ConnectionPool(const ConnectionPool&) = delete;
+
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Returns an idle connection, or connects a new one.
+    std::unique_ptr<Connection> acquire();
+
+    // Connects a new connection.
+    std::unique_ptr<Connection> connect();
+
+    // Keeps `connection` for a later request unless enough are idle.
+    void release(std::unique_ptr<Connection>&& connection);
+
+    // Closes the idle connections.
+    void clear();
+
+    const IPAddress& serverAddr() const { return _serverAddr; }
+
+  private:
+    IPAddress _serverAddr;
+    size_t _maxIdleConnections;
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<Connection>> _idle;
+};
+
+}  // namespace http
+}  // namespace net
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_NET_HTTP_CONNECTIONPOOL_H
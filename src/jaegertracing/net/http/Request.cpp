@@ -18,10 +18,30 @@
 #include "jaegertracing/net/http/SocketReader.h"
 
 #include <regex>
+#include <sstream>
+
+#include "jaegertracing/Constants.h"
 
 namespace jaegertracing {
 namespace net {
 namespace http {
+namespace {
+
+void writePostHead(std::ostream& out,
+                   const std::string& host,
+                   const std::string& target,
+                   const std::string& contentType,
+                   const std::string& framing)
+{
+    out << "POST " << target << " HTTP/1.1\r\n"
+        << "Host: " << host << "\r\n"
+        << "Content-Type: " << contentType << "\r\n"
+        << framing << "Accept: " << contentType << "\r\n"
+        << "User-Agent: jaegertracing/" << kJaegerClientVersion
+        << "\r\n\r\n";
+}
+
+}  // anonymous namespace
 
 Request Request::read(Socket & socket)
 {
@@ -54,6 +74,32 @@ Request Request::parse(std::istream& in)
     return request;
 }
 
+std::string formatPostHead(const std::string& host,
+                           const std::string& target,
+                           const std::string& contentType,
+                           size_t contentLength,
+                           const std::string& contentEncoding)
+{
+    std::ostringstream framing;
+    if (!contentEncoding.empty()) {
+        framing << "Content-Encoding: " << contentEncoding << "\r\n";
+    }
+    framing << "Content-Length: " << contentLength << "\r\n";
+    std::ostringstream oss;
+    writePostHead(oss, host, target, contentType, framing.str());
+    return oss.str();
+}
+
+std::string formatChunkedPostHead(const std::string& host,
+                                  const std::string& target,
+                                  const std::string& contentType)
+{
+    std::ostringstream oss;
+    writePostHead(
+        oss, host, target, contentType, "Transfer-Encoding: chunked\r\n");
+    return oss.str();
+}
+
 }  // namespace http
 }  // namespace net
 }  // namespace jaegertracing
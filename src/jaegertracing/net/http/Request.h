@@ -59,6 +59,20 @@ class Request {
     std::string _body;
 };
 
+// Formats the request line and headers of a POST of `contentLength` bytes
+// of `contentType` to `target` on `host`. Content-Encoding is only written
+// when `contentEncoding` is not empty.
+std::string formatPostHead(const std::string& host,
+                           const std::string& target,
+                           const std::string& contentType,
+                           size_t contentLength,
+                           const std::string& contentEncoding);
+
+// Like formatPostHead(), for a body sent with chunked transfer encoding.
+std::string formatChunkedPostHead(const std::string& host,
+                                  const std::string& target,
+                                  const std::string& contentType);
+
 }  // namespace http
 }  // namespace net
 }  // namespace jaegertracing
@@ -17,6 +17,9 @@
 #include "jaegertracing/net/http/Response.h"
 #include "jaegertracing/net/http/SocketReader.h"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
@@ -31,6 +34,41 @@
 namespace jaegertracing {
 namespace net {
 namespace http {
+namespace {
+
+// Appends what the socket has to `buffer`, returns false at end of stream.
+bool receive(Socket& socket, std::string& buffer)
+{
+    constexpr auto kBufferSize = 4096;
+    std::array<char, kBufferSize> chunk;
+    const auto numRead = ::recv(socket.handle(), &chunk[0], chunk.size(), 0);
+    if (numRead < 0) {
+        throw std::system_error(
+            errno, std::system_category(), "Failed to read HTTP response");
+    }
+    buffer.append(&chunk[0], numRead);
+    return numRead > 0;
+}
+
+std::string toLower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), [](char ch) {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    });
+    return str;
+}
+
+std::string findHeader(const Response& response, const std::string& key)
+{
+    for (auto&& header : response.headers()) {
+        if (toLower(header.key()) == key) {
+            return toLower(header.value());
+        }
+    }
+    return std::string();
+}
+
+}  // anonymous namespace
 
 Response Response::parse(std::istream& in)
 {
@@ -62,6 +100,100 @@ Response read(Socket & socket)
   return Response::parse(responseStream);
 }
 
+bool parseResponse(std::string& buffer,
+                   bool atEnd,
+                   Response& response,
+                   bool& reusable)
+{
+    auto headerEnd = buffer.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return false;
+    }
+    headerEnd += 4;
+
+    std::string message(buffer, 0, headerEnd);
+    std::istringstream headStream(message);
+    const auto head = Response::parse(headStream);
+
+    auto pos = headerEnd;
+    const auto statusCode = head.statusCode();
+    const auto contentLength = findHeader(head, "content-length");
+    auto closeDelimited = false;
+    if ((statusCode >= 100 && statusCode < 200) || statusCode == 204 ||
+        statusCode == 304) {
+        // No body.
+    }
+    else if (findHeader(head, "transfer-encoding").find("chunked") !=
+             std::string::npos) {
+        while (true) {
+            auto lineEnd = buffer.find("\r\n", pos);
+            if (lineEnd == std::string::npos) {
+                return false;
+            }
+            const auto size =
+                std::stoul(buffer.substr(pos, lineEnd - pos), nullptr, 16);
+            pos = lineEnd + 2;
+            if (size == 0) {
+                // Skip trailers up to the final empty line.
+                while ((lineEnd = buffer.find("\r\n", pos)) != pos) {
+                    if (lineEnd == std::string::npos) {
+                        return false;
+                    }
+                    pos = lineEnd + 2;
+                }
+                pos += 2;
+                break;
+            }
+            if (buffer.size() < pos + size + 2) {
+                return false;
+            }
+            message.append(buffer, pos, size);
+            pos += size + 2;
+        }
+    }
+    else if (!contentLength.empty()) {
+        const auto size = std::stoul(contentLength);
+        if (buffer.size() < pos + size) {
+            return false;
+        }
+        message.append(buffer, pos, size);
+        pos += size;
+    }
+    else {
+        // The body ends with the connection.
+        if (!atEnd) {
+            return false;
+        }
+        message.append(buffer, pos, std::string::npos);
+        pos = buffer.size();
+        closeDelimited = true;
+    }
+    buffer.erase(0, pos);
+
+    const auto connection = findHeader(head, "connection");
+    reusable = !closeDelimited &&
+               (head.version() == "1.0" ? connection == "keep-alive"
+                                        : connection != "close");
+
+    std::istringstream responseStream(message);
+    response = Response::parse(responseStream);
+    return true;
+}
+
+Response read(Socket& socket, std::string& pending, bool& reusable)
+{
+    Response response;
+    auto atEnd = false;
+    while (!parseResponse(pending, atEnd, response, reusable)) {
+        if (atEnd) {
+            throw std::runtime_error(
+                "Connection closed before end of HTTP response");
+        }
+        atEnd = !receive(socket, pending);
+    }
+    return response;
+}
+
 Response get(const URI& uri)
 {
     Socket socket;
@@ -40,6 +40,8 @@ class Response {
     {
     }
 
+    const std::string& version() const { return _version; }
+
     int statusCode() const { return _statusCode; }
 
     const std::string& reason() const { return _reason; }
@@ -63,6 +65,26 @@ Response get(const URI& uri);
  */
 Response read(Socket& socket);
 
+/**
+ * Reads one http response from a connection that may carry further
+ * requests. The end of the body is found from the Content-Length header or
+ * chunked encoding rather than from short reads. Bytes received past the
+ * response are kept in `pending` for the next call. Sets `reusable` to false
+ * if the connection cannot carry another request.
+ */
+Response read(Socket& socket, std::string& pending, bool& reusable);
+
+/**
+ * Parses the response at the start of `buffer` and removes it from there.
+ * Returns false if the buffer does not hold all of it yet. `atEnd` tells
+ * that no more bytes will arrive, which ends a body sent without length.
+ * Sets `reusable` as read() does.
+ */
+bool parseResponse(std::string& buffer,
+                   bool atEnd,
+                   Response& response,
+                   bool& reusable);
+
 }  // namespace http
 }  // namespace net
 }  // namespace jaegertracing
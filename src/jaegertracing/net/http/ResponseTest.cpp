@@ -98,6 +98,53 @@ TEST(Response, get)
     clientThread.join();
 }
 
+TEST(Response, readKeepAlive)
+{
+    Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(IPAddress::v4("127.0.0.1", 0));
+    socket.listen();
+
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const IPAddress serverAddress(addrStorage, addrLen);
+
+    std::thread serverThread([&socket]() {
+        auto clientSocket = socket.accept();
+        // Both responses arrive in one read.
+        const std::string responses("HTTP/1.1 202 Accepted\r\n"
+                                    "Content-Length: 5\r\n\r\n"
+                                    "first"
+                                    "HTTP/1.1 200 OK\r\n"
+                                    "Transfer-Encoding: chunked\r\n"
+                                    "Connection: close\r\n\r\n"
+                                    "3\r\nsec\r\n3\r\nond\r\n0\r\n\r\n");
+        ::send(clientSocket.handle(), responses.c_str(), responses.size(), 0);
+    });
+
+    Socket clientSocket;
+    clientSocket.open(AF_INET, SOCK_STREAM);
+    clientSocket.connect(serverAddress);
+    std::string pending;
+    auto reusable = false;
+
+    const auto first = read(clientSocket, pending, reusable);
+    ASSERT_EQ(202, first.statusCode());
+    ASSERT_EQ("first", first.body());
+    ASSERT_TRUE(reusable);
+
+    const auto second = read(clientSocket, pending, reusable);
+    ASSERT_EQ(200, second.statusCode());
+    ASSERT_EQ("second", second.body());
+    ASSERT_FALSE(reusable);
+    ASSERT_TRUE(pending.empty());
+
+    serverThread.join();
+}
+
 }  // namespace http
 }  // namespace net
 }  // namespace jaegertracing
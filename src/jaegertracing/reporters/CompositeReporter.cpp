@@ -15,3 +15,24 @@
  */
 
 #include "jaegertracing/reporters/CompositeReporter.h"
+#include "jaegertracing/Span.h"
+
+namespace jaegertracing {
+namespace reporters {
+
+void CompositeReporter::report(std::unique_ptr<Span>&& span) noexcept
+{
+    if (!span || _reporters.empty()) {
+        return;
+    }
+    // Every reporter but the last only reads the span, the last one gets to
+    // keep it.
+    const auto last = std::prev(std::end(_reporters));
+    for (auto itr = std::begin(_reporters); itr != last; ++itr) {
+        (*itr)->report(*span);
+    }
+    (*last)->report(std::move(span));
+}
+
+}  // namespace reporters
+}  // namespace jaegertracing
@@ -49,6 +49,8 @@ class CompositeReporter : public Reporter {
             [&span](const ReporterPtr& reporter) { reporter->report(span); });
     }
 
+    void report(std::unique_ptr<Span>&& span) noexcept override;
+
     void close() noexcept override
     {
         std::for_each(std::begin(_reporters),
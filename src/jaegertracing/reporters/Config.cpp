@@ -15,13 +15,17 @@
  */
 
 #include <algorithm>
+#include <iostream>
 
 #include "jaegertracing/reporters/Config.h"
 #include "jaegertracing/ThriftSender.h"
 #include "jaegertracing/reporters/CompositeReporter.h"
 #include "jaegertracing/reporters/LoggingReporter.h"
 #include "jaegertracing/reporters/RemoteReporter.h"
+#include "jaegertracing/utils/AsyncHTTPTransporter.h"
 #include "jaegertracing/utils/EnvVariable.h"
+#include "jaegertracing/utils/SharedMemoryTransporter.h"
+#include "jaegertracing/utils/UnixTransporter.h"
 
 namespace jaegertracing {
 namespace reporters {
@@ -29,6 +33,18 @@ namespace reporters {
 constexpr int Config::kDefaultQueueSize;
 constexpr const char* Config::kDefaultLocalAgentHostPort;
 constexpr const char* Config::kDefaultEndpoint;
+constexpr int Config::kDefaultThreadBufferSize;
+constexpr size_t Config::kDefaultQueueSizeBytes;
+constexpr int Config::kDefaultPriorityQueueSize;
+constexpr int Config::kDefaultSerializerThreads;
+constexpr int Config::kDefaultSenderThreads;
+constexpr int64_t Config::kDefaultRetryBufferSize;
+constexpr int Config::kDefaultUDPPacketsPerSend;
+constexpr int Config::kDefaultHTTPMaxInFlight;
+constexpr int Config::kDefaultCompressionLevel;
+constexpr int Config::kDefaultHTTPChunkSize;
+constexpr int Config::kDefaultHTTPMaxBatchSize;
+constexpr size_t Config::kDefaultSharedMemoryRingSize;
 constexpr const char* Config::kJAEGER_AGENT_HOST_ENV_PROP;
 constexpr const char* Config::kJAEGER_AGENT_PORT_ENV_PROP;
 constexpr const char* Config::kJAEGER_ENDPOINT_ENV_PROP;
@@ -36,22 +52,185 @@ constexpr const char* Config::kJAEGER_ENDPOINT_ENV_PROP;
 constexpr const char* Config::kJAEGER_REPORTER_LOG_SPANS_ENV_PROP;
 constexpr const char* Config::kJAEGER_REPORTER_FLUSH_INTERVAL_ENV_PROP;
 constexpr const char* Config::kJAEGER_REPORTER_MAX_QUEUE_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_THREAD_BUFFER_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_THREAD_BUFFER_MAX_AGE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_OVERFLOW_POLICY_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_BLOCK_TIMEOUT_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_PRIORITY_QUEUE_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_SERIALIZER_THREADS_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_SENDER_THREADS_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_RETRY_BUFFER_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_UDP_PACKETS_PER_SEND_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_HTTP_MAX_IN_FLIGHT_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_COMPRESSION_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_COMPRESSION_LEVEL_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_HTTP_CHUNK_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_HTTP_MAX_BATCH_SIZE_ENV_PROP;
+constexpr const char*
+    Config::kJAEGER_REPORTER_SHARED_MEMORY_RING_SIZE_ENV_PROP;
+constexpr const char* Config::kJAEGER_REPORTER_IO_BACKEND_ENV_PROP;
+
+namespace {
+
+// Whether `address` names an agent's Unix socket, like "unix:///path",
+// rather than a host and port.
+bool parseUnixAddress(const std::string& address,
+                      std::string& path,
+                      int& socketType)
+{
+#ifndef WIN32
+    return utils::UnixTransporter::parseAddress(address, path, socketType);
+#else
+    (void)address;
+    (void)path;
+    (void)socketType;
+    return false;
+#endif
+}
+
+// Whether `address` names a socket or file on this host rather than a host
+// and port.
+bool isLocalAgentPath(const std::string& address)
+{
+    std::string path;
+    auto socketType = 0;
+    if (parseUnixAddress(address, path, socketType)) {
+        return true;
+    }
+#ifndef WIN32
+    return utils::SharedMemoryRing::parseAddress(address, path);
+#else
+    return false;
+#endif
+}
+
+// Compresses batches sent to the collector, unless the configured codec
+// is not built in, in which case they are sent uncompressed.
+std::unique_ptr<utils::Compressor> makeCompressor(const Config& config,
+                                                  logging::Logger& logger,
+                                                  metrics::Metrics& metrics)
+{
+    const auto compression = config.compression();
+    if (compression == utils::Compression::kNone) {
+        return nullptr;
+    }
+    if (!utils::Compressor::available(compression)) {
+        logger.error("Reporter compression is not available in this build, "
+                     "sending batches uncompressed");
+        return nullptr;
+    }
+    return std::unique_ptr<utils::Compressor>(new utils::Compressor(
+        compression, config.compressionLevel(), metrics));
+}
+
+std::unique_ptr<Sender>
+makeSender(const Config& config,
+           const std::shared_ptr<net::http::ConnectionPool>& connections,
+           const std::shared_ptr<utils::SharedMemoryRing>& ring,
+           logging::Logger& logger,
+           metrics::Metrics& metrics)
+{
+    std::string unixPath;
+    auto unixSocketType = 0;
+    std::unique_ptr<utils::Transport> transporter;
+    if (config.endpoint().empty() && !ring &&
+        !parseUnixAddress(
+            config.localAgentHostPort(), unixPath, unixSocketType)) {
+        transporter.reset(new utils::UDPTransporter(
+            net::IPAddress::v4(config.localAgentHostPort()),
+            0,
+            config.udpPacketsPerSend(),
+            config.ioBackend(),
+            &metrics));
+    }
+#ifndef WIN32
+    else if (config.endpoint().empty() && ring) {
+        transporter.reset(new utils::SharedMemoryTransporter(ring));
+    }
+    else if (config.endpoint().empty()) {
+        transporter.reset(
+            new utils::UnixTransporter(unixPath,
+                                       0,
+                                       config.udpPacketsPerSend(),
+                                       unixSocketType,
+                                       config.ioBackend(),
+                                       &metrics));
+    }
+#endif
+#ifdef __linux__
+    else if (config.httpMaxInFlight() > 0) {
+        transporter.reset(new utils::AsyncHTTPTransporter(
+            net::URI::parse(config.endpoint()),
+            config.httpMaxBatchSize(),
+            config.httpMaxInFlight(),
+            logger,
+            metrics,
+            makeCompressor(config, logger, metrics)));
+    }
+#endif
+    else {
+        transporter.reset(new utils::HTTPTransporter(
+            net::URI::parse(config.endpoint()),
+            config.httpMaxBatchSize(),
+            connections,
+            makeCompressor(config, logger, metrics),
+            config.httpChunkSize(),
+            config.ioBackend()));
+    }
+
+    return std::unique_ptr<Sender>(new ThriftSender(
+        std::forward<std::unique_ptr<utils::Transport>>(transporter),
+        config.retryBufferSize()));
+}
+
+}  // anonymous namespace
 
 std::unique_ptr<Reporter> Config::makeReporter(const std::string& serviceName,
                                                logging::Logger& logger,
                                                metrics::Metrics& metrics) const
 {
-    std::unique_ptr<utils::Transport> transporter =
-        _endpoint.empty()
-            ? (std::unique_ptr<utils::Transport>(new utils::UDPTransporter(
-                  net::IPAddress::v4(_localAgentHostPort), 0)))
-            : (std::unique_ptr<utils::Transport>(
-                  new utils::HTTPTransporter(net::URI::parse(_endpoint), 0)));
-
-    std::unique_ptr<ThriftSender> sender(new ThriftSender(
-        std::forward<std::unique_ptr<utils::Transport>>(transporter)));
-    std::unique_ptr<RemoteReporter> remoteReporter(new RemoteReporter(
-        _bufferFlushInterval, _queueSize, std::move(sender), logger, metrics));
+    // Senders on separate threads share the keep-alive connections to the
+    // collector.
+    std::shared_ptr<net::http::ConnectionPool> connections;
+    if (!_endpoint.empty()) {
+        const auto uri = net::URI::parse(_endpoint);
+        connections = std::make_shared<net::http::ConnectionPool>(
+            net::IPAddress::v4(uri._host, uri._port), _senderThreads);
+    }
+    // So do the ones writing to the ring file of a local consumer.
+    std::shared_ptr<utils::SharedMemoryRing> ring;
+#ifndef WIN32
+    std::string ringPath;
+    if (_endpoint.empty() &&
+        utils::SharedMemoryRing::parseAddress(_localAgentHostPort, ringPath)) {
+        ring = std::make_shared<utils::SharedMemoryRing>(
+            ringPath, _sharedMemoryRingSize);
+    }
+#endif
+    const auto config = *this;
+    auto* loggerPtr = &logger;
+    auto* metricsPtr = &metrics;
+    const RemoteReporter::SenderFactory senderFactory =
+        [config, connections, ring, loggerPtr, metricsPtr]() {
+            return makeSender(
+                config, connections, ring, *loggerPtr, *metricsPtr);
+        };
+    std::unique_ptr<RemoteReporter> remoteReporter(
+        new RemoteReporter(_bufferFlushInterval,
+                           _queueSize,
+                           senderFactory(),
+                           logger,
+                           metrics,
+                           _threadBufferSize,
+                           _threadBufferMaxAge,
+                           static_cast<int64_t>(_queueSizeBytes),
+                           _overflowPolicy,
+                           _blockTimeout,
+                           _priorityQueueSize,
+                           _serializerThreads,
+                           _senderThreads,
+                           senderFactory));
     if (_logSpans) {
         logger.info("Initializing logging reporter");
         return std::unique_ptr<CompositeReporter>(new CompositeReporter(
@@ -65,7 +244,10 @@ void Config::fromEnv()
 {
     const auto agentHost =
         utils::EnvVariable::getStringVariable(kJAEGER_AGENT_HOST_ENV_PROP);
-    if (!agentHost.empty()) {
+    if (isLocalAgentPath(agentHost)) {
+        _localAgentHostPort = agentHost;
+    }
+    else if (!agentHost.empty()) {
         auto agentHostPort = net::IPAddress::parse(_localAgentHostPort);
         std::ostringstream oss;
         oss << agentHost << ":" << agentHostPort.second;
@@ -73,7 +255,7 @@ void Config::fromEnv()
     }
     const auto agentPort =
         utils::EnvVariable::getStringVariable(kJAEGER_AGENT_PORT_ENV_PROP);
-    if (!agentPort.empty()) {
+    if (!agentPort.empty() && !isLocalAgentPath(_localAgentHostPort)) {
         std::istringstream iss(agentPort);
         int port = 0;
         if (iss >> port) {
@@ -112,6 +294,195 @@ void Config::fromEnv()
             _queueSize = maxQueueSize.second;
         }
     }
+
+    const auto maxQueueSizeBytes = utils::EnvVariable::getSizeVariable(
+        kJAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES_ENV_PROP);
+    if (maxQueueSizeBytes.first && maxQueueSizeBytes.second > 0) {
+        _queueSizeBytes = maxQueueSizeBytes.second;
+    }
+
+    const auto overflowPolicy = utils::EnvVariable::getStringVariable(
+        kJAEGER_REPORTER_OVERFLOW_POLICY_ENV_PROP);
+    if (!overflowPolicy.empty()) {
+        _overflowPolicy = parseOverflowPolicy(overflowPolicy);
+    }
+
+    const auto blockTimeout = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_BLOCK_TIMEOUT_ENV_PROP);
+    if (!blockTimeout.first) {
+        if (blockTimeout.second > 0) {
+            _blockTimeout = std::chrono::milliseconds(blockTimeout.second);
+        }
+    }
+
+    const auto priorityQueueSize = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_PRIORITY_QUEUE_SIZE_ENV_PROP);
+    if (!priorityQueueSize.first) {
+        if (priorityQueueSize.second > 0) {
+            _priorityQueueSize = priorityQueueSize.second;
+        }
+    }
+
+    const auto serializerThreads = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_SERIALIZER_THREADS_ENV_PROP);
+    if (!serializerThreads.first) {
+        if (serializerThreads.second > 0) {
+            _serializerThreads = serializerThreads.second;
+        }
+    }
+
+    const auto senderThreads = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_SENDER_THREADS_ENV_PROP);
+    if (!senderThreads.first) {
+        if (senderThreads.second > 0) {
+            _senderThreads = senderThreads.second;
+        }
+    }
+
+    const auto retryBufferSize = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_RETRY_BUFFER_SIZE_ENV_PROP);
+    if (!retryBufferSize.first) {
+        if (retryBufferSize.second > 0) {
+            _retryBufferSize = retryBufferSize.second;
+        }
+    }
+
+    const auto udpPacketsPerSend = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_UDP_PACKETS_PER_SEND_ENV_PROP);
+    if (!udpPacketsPerSend.first) {
+        if (udpPacketsPerSend.second > 0) {
+            _udpPacketsPerSend = udpPacketsPerSend.second;
+        }
+    }
+
+    const auto httpMaxInFlight = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_HTTP_MAX_IN_FLIGHT_ENV_PROP);
+    if (!httpMaxInFlight.first) {
+        if (httpMaxInFlight.second > 0) {
+            _httpMaxInFlight = httpMaxInFlight.second;
+        }
+    }
+
+    const auto compression = utils::EnvVariable::getStringVariable(
+        kJAEGER_REPORTER_COMPRESSION_ENV_PROP);
+    if (!compression.empty()) {
+        _compression = parseCompression(compression);
+    }
+
+    const auto compressionLevel = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_COMPRESSION_LEVEL_ENV_PROP);
+    if (!compressionLevel.first) {
+        if (compressionLevel.second > 0) {
+            _compressionLevel = compressionLevel.second;
+        }
+    }
+
+    const auto httpChunkSize = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_HTTP_CHUNK_SIZE_ENV_PROP);
+    if (!httpChunkSize.first) {
+        if (httpChunkSize.second > 0) {
+            _httpChunkSize = httpChunkSize.second;
+        }
+    }
+
+    const auto httpMaxBatchSize = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_HTTP_MAX_BATCH_SIZE_ENV_PROP);
+    if (!httpMaxBatchSize.first) {
+        if (httpMaxBatchSize.second > 0) {
+            _httpMaxBatchSize = httpMaxBatchSize.second;
+        }
+    }
+
+    const auto sharedMemoryRingSize = utils::EnvVariable::getSizeVariable(
+        kJAEGER_REPORTER_SHARED_MEMORY_RING_SIZE_ENV_PROP);
+    if (sharedMemoryRingSize.first && sharedMemoryRingSize.second > 0) {
+        _sharedMemoryRingSize = sharedMemoryRingSize.second;
+    }
+
+    const auto ioBackend = utils::EnvVariable::getStringVariable(
+        kJAEGER_REPORTER_IO_BACKEND_ENV_PROP);
+    if (!ioBackend.empty()) {
+        _ioBackend = parseIOBackend(ioBackend);
+    }
+
+    const auto threadBufferSize = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_THREAD_BUFFER_SIZE_ENV_PROP);
+    if (!threadBufferSize.first) {
+        if (threadBufferSize.second > 0) {
+            _threadBufferSize = threadBufferSize.second;
+        }
+    }
+
+    const auto threadBufferMaxAge = utils::EnvVariable::getIntVariable(
+        kJAEGER_REPORTER_THREAD_BUFFER_MAX_AGE_ENV_PROP);
+    if (!threadBufferMaxAge.first) {
+        if (threadBufferMaxAge.second > 0) {
+            _threadBufferMaxAge =
+                std::chrono::milliseconds(threadBufferMaxAge.second);
+        }
+    }
+}
+
+OverflowPolicy Config::parseOverflowPolicy(const std::string& policy)
+{
+    if (policy.empty() || policy == "drop-newest") {
+        return OverflowPolicy::kDropNewest;
+    }
+    if (policy == "drop-oldest") {
+        return OverflowPolicy::kDropOldest;
+    }
+    if (policy == "block") {
+        return OverflowPolicy::kBlock;
+    }
+    std::cerr << "ERROR: unknown reporter overflow policy '" << policy
+              << "', falling back to drop-newest";
+    return OverflowPolicy::kDropNewest;
+}
+
+utils::Compression Config::parseCompression(const std::string& compression)
+{
+    auto result = utils::Compression::kNone;
+    if (compression.empty() || compression == "none") {
+        return result;
+    }
+    if (compression == "gzip") {
+        result = utils::Compression::kGzip;
+    }
+    else if (compression == "zstd") {
+        result = utils::Compression::kZstd;
+    }
+    else {
+        std::cerr << "ERROR: unknown reporter compression '" << compression
+                  << "', sending batches uncompressed";
+        return utils::Compression::kNone;
+    }
+    if (!utils::Compressor::available(result)) {
+        std::cerr << "ERROR: reporter compression '" << compression
+                  << "' is not available in this build, sending batches "
+                     "uncompressed";
+        return utils::Compression::kNone;
+    }
+    return result;
+}
+
+utils::IOBackend Config::parseIOBackend(const std::string& ioBackend)
+{
+    if (ioBackend.empty() || ioBackend == "sockets") {
+        return utils::IOBackend::kSockets;
+    }
+    if (ioBackend != "io_uring") {
+        std::cerr << "ERROR: unknown reporter I/O backend '" << ioBackend
+                  << "', falling back to sockets";
+        return utils::IOBackend::kSockets;
+    }
+#ifdef __linux__
+    if (utils::IOUring::available()) {
+        return utils::IOBackend::kIOUring;
+    }
+#endif
+    std::cerr << "ERROR: reporter I/O backend 'io_uring' is not available in "
+                 "this build or kernel, falling back to sockets";
+    return utils::IOBackend::kSockets;
 }
 
 }  // namespace reporters
@@ -18,15 +18,19 @@
 #define JAEGERTRACING_REPORTERS_CONFIG_H
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 
 #include "jaegertracing/Logging.h"
 #include "jaegertracing/metrics/Metrics.h"
+#include "jaegertracing/reporters/OverflowPolicy.h"
 #include "jaegertracing/reporters/Reporter.h"
+#include "jaegertracing/utils/Compressor.h"
 #include "jaegertracing/utils/YAML.h"
 #include "jaegertracing/utils/HTTPTransporter.h"
+#include "jaegertracing/utils/IOUring.h"
 #include "jaegertracing/utils/UDPTransporter.h"
 
 namespace jaegertracing {
@@ -39,6 +43,19 @@ class Config {
     static constexpr auto kDefaultQueueSize = 100;
     static constexpr auto kDefaultLocalAgentHostPort = "127.0.0.1:6831";
     static constexpr auto kDefaultEndpoint = "";
+    static constexpr auto kDefaultThreadBufferSize = 0;
+    static constexpr size_t kDefaultQueueSizeBytes = 0;
+    static constexpr auto kDefaultPriorityQueueSize = 0;
+    static constexpr auto kDefaultSerializerThreads = 0;
+    static constexpr auto kDefaultSenderThreads = 1;
+    static constexpr int64_t kDefaultRetryBufferSize = 0;
+    static constexpr auto kDefaultUDPPacketsPerSend = 1;
+    static constexpr auto kDefaultHTTPMaxInFlight = 0;
+    static constexpr auto kDefaultCompressionLevel =
+        utils::Compressor::kDefaultLevel;
+    static constexpr auto kDefaultHTTPChunkSize = 0;
+    static constexpr auto kDefaultHTTPMaxBatchSize = 0;
+    static constexpr size_t kDefaultSharedMemoryRingSize = 16 * 1024 * 1024;
 
     static constexpr auto kJAEGER_AGENT_HOST_ENV_PROP = "JAEGER_AGENT_HOST";
     static constexpr auto kJAEGER_AGENT_PORT_ENV_PROP = "JAEGER_AGENT_PORT";
@@ -47,6 +64,23 @@ class Config {
     static constexpr auto kJAEGER_REPORTER_LOG_SPANS_ENV_PROP = "JAEGER_REPORTER_LOG_SPANS";
     static constexpr auto kJAEGER_REPORTER_FLUSH_INTERVAL_ENV_PROP = "JAEGER_REPORTER_FLUSH_INTERVAL";
     static constexpr auto kJAEGER_REPORTER_MAX_QUEUE_SIZE_ENV_PROP = "JAEGER_REPORTER_MAX_QUEUE_SIZE";
+    static constexpr auto kJAEGER_REPORTER_THREAD_BUFFER_SIZE_ENV_PROP = "JAEGER_REPORTER_THREAD_BUFFER_SIZE";
+    static constexpr auto kJAEGER_REPORTER_THREAD_BUFFER_MAX_AGE_ENV_PROP = "JAEGER_REPORTER_THREAD_BUFFER_MAX_AGE";
+    static constexpr auto kJAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES_ENV_PROP = "JAEGER_REPORTER_MAX_QUEUE_SIZE_BYTES";
+    static constexpr auto kJAEGER_REPORTER_OVERFLOW_POLICY_ENV_PROP = "JAEGER_REPORTER_OVERFLOW_POLICY";
+    static constexpr auto kJAEGER_REPORTER_BLOCK_TIMEOUT_ENV_PROP = "JAEGER_REPORTER_BLOCK_TIMEOUT";
+    static constexpr auto kJAEGER_REPORTER_PRIORITY_QUEUE_SIZE_ENV_PROP = "JAEGER_REPORTER_PRIORITY_QUEUE_SIZE";
+    static constexpr auto kJAEGER_REPORTER_SERIALIZER_THREADS_ENV_PROP = "JAEGER_REPORTER_SERIALIZER_THREADS";
+    static constexpr auto kJAEGER_REPORTER_SENDER_THREADS_ENV_PROP = "JAEGER_REPORTER_SENDER_THREADS";
+    static constexpr auto kJAEGER_REPORTER_RETRY_BUFFER_SIZE_ENV_PROP = "JAEGER_REPORTER_RETRY_BUFFER_SIZE";
+    static constexpr auto kJAEGER_REPORTER_UDP_PACKETS_PER_SEND_ENV_PROP = "JAEGER_REPORTER_UDP_PACKETS_PER_SEND";
+    static constexpr auto kJAEGER_REPORTER_HTTP_MAX_IN_FLIGHT_ENV_PROP = "JAEGER_REPORTER_HTTP_MAX_IN_FLIGHT";
+    static constexpr auto kJAEGER_REPORTER_COMPRESSION_ENV_PROP = "JAEGER_REPORTER_COMPRESSION";
+    static constexpr auto kJAEGER_REPORTER_COMPRESSION_LEVEL_ENV_PROP = "JAEGER_REPORTER_COMPRESSION_LEVEL";
+    static constexpr auto kJAEGER_REPORTER_HTTP_CHUNK_SIZE_ENV_PROP = "JAEGER_REPORTER_HTTP_CHUNK_SIZE";
+    static constexpr auto kJAEGER_REPORTER_HTTP_MAX_BATCH_SIZE_ENV_PROP = "JAEGER_REPORTER_HTTP_MAX_BATCH_SIZE";
+    static constexpr auto kJAEGER_REPORTER_SHARED_MEMORY_RING_SIZE_ENV_PROP = "JAEGER_REPORTER_SHARED_MEMORY_RING_SIZE";
+    static constexpr auto kJAEGER_REPORTER_IO_BACKEND_ENV_PROP = "JAEGER_REPORTER_IO_BACKEND";
 
 
 
@@ -55,6 +89,22 @@ class Config {
         return std::chrono::seconds(10);
     }
 
+    static Clock::duration defaultThreadBufferMaxAge()
+    {
+        return std::chrono::milliseconds(100);
+    }
+
+    static Clock::duration defaultBlockTimeout()
+    {
+        return std::chrono::milliseconds(100);
+    }
+
+    static OverflowPolicy parseOverflowPolicy(const std::string& policy);
+
+    static utils::Compression parseCompression(const std::string& compression);
+
+    static utils::IOBackend parseIOBackend(const std::string& ioBackend);
+
 #ifdef JAEGERTRACING_WITH_YAML_CPP
 
     static Config parse(const YAML::Node& configYAML)
@@ -74,8 +124,71 @@ class Config {
             configYAML, "localAgentHostPort", "");
         const auto endpoint = utils::yaml::findOrDefault<std::string>(
             configYAML, "endpoint", "");
-        return Config(
-            queueSize, bufferFlushInterval, logSpans, localAgentHostPort, endpoint);
+        const auto threadBufferSize = utils::yaml::findOrDefault<int>(
+            configYAML, "threadBufferSize", kDefaultThreadBufferSize);
+        const auto threadBufferMaxAge =
+            std::chrono::milliseconds(utils::yaml::findOrDefault<int>(
+                configYAML, "threadBufferMaxAge", 0));
+        const auto queueSizeBytes = utils::yaml::findOrDefault<int64_t>(
+            configYAML, "queueSizeBytes", 0);
+        const auto overflowPolicy =
+            parseOverflowPolicy(utils::yaml::findOrDefault<std::string>(
+                configYAML, "overflowPolicy", ""));
+        const auto blockTimeout =
+            std::chrono::milliseconds(utils::yaml::findOrDefault<int>(
+                configYAML, "blockTimeout", 0));
+        const auto priorityQueueSize = utils::yaml::findOrDefault<int>(
+            configYAML, "priorityQueueSize", kDefaultPriorityQueueSize);
+        const auto serializerThreads = utils::yaml::findOrDefault<int>(
+            configYAML, "serializerThreads", kDefaultSerializerThreads);
+        const auto senderThreads = utils::yaml::findOrDefault<int>(
+            configYAML, "senderThreads", kDefaultSenderThreads);
+        const auto retryBufferSize = utils::yaml::findOrDefault<int64_t>(
+            configYAML, "retryBufferSize", kDefaultRetryBufferSize);
+        const auto udpPacketsPerSend = utils::yaml::findOrDefault<int>(
+            configYAML, "udpPacketsPerSend", kDefaultUDPPacketsPerSend);
+        const auto httpMaxInFlight = utils::yaml::findOrDefault<int>(
+            configYAML, "httpMaxInFlight", kDefaultHTTPMaxInFlight);
+        const auto compression =
+            parseCompression(utils::yaml::findOrDefault<std::string>(
+                configYAML, "compression", ""));
+        const auto compressionLevel = utils::yaml::findOrDefault<int>(
+            configYAML, "compressionLevel", kDefaultCompressionLevel);
+        const auto httpChunkSize = utils::yaml::findOrDefault<int>(
+            configYAML, "httpChunkSize", kDefaultHTTPChunkSize);
+        const auto httpMaxBatchSize = utils::yaml::findOrDefault<int>(
+            configYAML, "httpMaxBatchSize", kDefaultHTTPMaxBatchSize);
+        const auto sharedMemoryRingSize = utils::yaml::findOrDefault<int64_t>(
+            configYAML, "sharedMemoryRingSize", 0);
+        const auto ioBackend =
+            parseIOBackend(utils::yaml::findOrDefault<std::string>(
+                configYAML, "ioBackend", ""));
+        return Config(queueSize,
+                      bufferFlushInterval,
+                      logSpans,
+                      localAgentHostPort,
+                      endpoint,
+                      threadBufferSize,
+                      threadBufferMaxAge,
+                      queueSizeBytes > 0
+                          ? static_cast<size_t>(queueSizeBytes)
+                          : kDefaultQueueSizeBytes,
+                      overflowPolicy,
+                      blockTimeout,
+                      priorityQueueSize,
+                      serializerThreads,
+                      senderThreads,
+                      retryBufferSize,
+                      udpPacketsPerSend,
+                      httpMaxInFlight,
+                      compression,
+                      compressionLevel,
+                      httpChunkSize,
+                      httpMaxBatchSize,
+                      sharedMemoryRingSize > 0
+                          ? static_cast<size_t>(sharedMemoryRingSize)
+                          : kDefaultSharedMemoryRingSize,
+                      ioBackend);
     }
 
 #endif  // JAEGERTRACING_WITH_YAML_CPP
@@ -85,7 +198,25 @@ class Config {
         const Clock::duration& bufferFlushInterval =
             defaultBufferFlushInterval(),
         bool logSpans = false,
-        const std::string& localAgentHostPort = kDefaultLocalAgentHostPort, const std::string& endpoint = kDefaultEndpoint)
+        const std::string& localAgentHostPort = kDefaultLocalAgentHostPort, const std::string& endpoint = kDefaultEndpoint,
+        int threadBufferSize = kDefaultThreadBufferSize,
+        const Clock::duration& threadBufferMaxAge =
+            defaultThreadBufferMaxAge(),
+        size_t queueSizeBytes = kDefaultQueueSizeBytes,
+        OverflowPolicy overflowPolicy = OverflowPolicy::kDropNewest,
+        const Clock::duration& blockTimeout = defaultBlockTimeout(),
+        int priorityQueueSize = kDefaultPriorityQueueSize,
+        int serializerThreads = kDefaultSerializerThreads,
+        int senderThreads = kDefaultSenderThreads,
+        int64_t retryBufferSize = kDefaultRetryBufferSize,
+        int udpPacketsPerSend = kDefaultUDPPacketsPerSend,
+        int httpMaxInFlight = kDefaultHTTPMaxInFlight,
+        utils::Compression compression = utils::Compression::kNone,
+        int compressionLevel = kDefaultCompressionLevel,
+        int httpChunkSize = kDefaultHTTPChunkSize,
+        int httpMaxBatchSize = kDefaultHTTPMaxBatchSize,
+        size_t sharedMemoryRingSize = kDefaultSharedMemoryRingSize,
+        utils::IOBackend ioBackend = utils::IOBackend::kSockets)
         : _queueSize(queueSize > 0 ? queueSize : kDefaultQueueSize)
         , _bufferFlushInterval(bufferFlushInterval.count() > 0
                                    ? bufferFlushInterval
@@ -95,6 +226,31 @@ class Config {
                                   ? kDefaultLocalAgentHostPort
                                   : localAgentHostPort)
         , _endpoint(endpoint)
+        , _threadBufferSize(threadBufferSize > 0 ? threadBufferSize : 0)
+        , _threadBufferMaxAge(threadBufferMaxAge.count() > 0
+                                  ? threadBufferMaxAge
+                                  : defaultThreadBufferMaxAge())
+        , _queueSizeBytes(queueSizeBytes)
+        , _overflowPolicy(overflowPolicy)
+        , _blockTimeout(blockTimeout.count() > 0 ? blockTimeout
+                                                 : defaultBlockTimeout())
+        , _priorityQueueSize(priorityQueueSize > 0 ? priorityQueueSize : 0)
+        , _serializerThreads(serializerThreads > 0 ? serializerThreads : 0)
+        , _senderThreads(senderThreads > 0 ? senderThreads
+                                           : kDefaultSenderThreads)
+        , _retryBufferSize(retryBufferSize > 0 ? retryBufferSize : 0)
+        , _udpPacketsPerSend(udpPacketsPerSend > 0 ? udpPacketsPerSend
+                                                   : kDefaultUDPPacketsPerSend)
+        , _httpMaxInFlight(httpMaxInFlight > 0 ? httpMaxInFlight : 0)
+        , _compression(compression)
+        , _compressionLevel(compressionLevel > 0 ? compressionLevel
+                                                 : kDefaultCompressionLevel)
+        , _httpChunkSize(httpChunkSize > 0 ? httpChunkSize : 0)
+        , _httpMaxBatchSize(httpMaxBatchSize > 0 ? httpMaxBatchSize : 0)
+        , _sharedMemoryRingSize(sharedMemoryRingSize > 0
+                                    ? sharedMemoryRingSize
+                                    : kDefaultSharedMemoryRingSize)
+        , _ioBackend(ioBackend)
     {
     }
 
@@ -104,6 +260,65 @@ class Config {
 
     int queueSize() const { return _queueSize; }
 
+    // Upper bound on the estimated memory held by queued spans; 0 leaves
+    // the queue bounded by span count only.
+    size_t queueSizeBytes() const { return _queueSizeBytes; }
+
+    OverflowPolicy overflowPolicy() const { return _overflowPolicy; }
+
+    // How long report() waits for room under OverflowPolicy::kBlock.
+    const Clock::duration& blockTimeout() const { return _blockTimeout; }
+
+    // Capacity of a separate queue for debug spans, including spans with
+    // sampling.priority set, so they survive load shedding; 0 disables it.
+    int priorityQueueSize() const { return _priorityQueueSize; }
+
+    // Number of threads converting spans to Thrift. When non-zero, spans are
+    // serialized and sent on worker threads instead of the reporter's single
+    // background thread.
+    int serializerThreads() const { return _serializerThreads; }
+
+    // Number of threads sending batches when serializerThreads() is
+    // non-zero, each with its own sender and socket.
+    int senderThreads() const { return _senderThreads; }
+
+    // Bytes of batches each sender keeps for another attempt after a failed
+    // send, backing off between attempts; 0 drops them and retries nothing.
+    int64_t retryBufferSize() const { return _retryBufferSize; }
+
+    // Number of full UDP packets, or Unix socket datagrams, sent together
+    // with one sendmmsg() call when the reporter is behind; 1 sends each
+    // packet as it fills up.
+    int udpPacketsPerSend() const { return _udpPacketsPerSend; }
+
+    // Number of batches posted to the collector without waiting for the
+    // previous responses, each on its own connection; 0 waits for each
+    // response. Only used on Linux.
+    int httpMaxInFlight() const { return _httpMaxInFlight; }
+
+    // Content encoding of the batches posted to the collector.
+    utils::Compression compression() const { return _compression; }
+
+    // Level passed to the compression codec; 0 uses the codec's default.
+    int compressionLevel() const { return _compressionLevel; }
+
+    // Size of the chunks uncompressed batches are streamed to the collector
+    // in while they are encoded; 0 encodes each batch to memory before
+    // posting it. Only used when httpMaxInFlight() is 0.
+    int httpChunkSize() const { return _httpChunkSize; }
+
+    // Upper bound on the encoded size of the batches posted to the
+    // collector; 0 uses the transporter's default of 1MB.
+    int httpMaxBatchSize() const { return _httpMaxBatchSize; }
+
+    // Bytes of records in the ring file created for a "shm:///path" agent
+    // address. A ring file that already exists keeps its size.
+    size_t sharedMemoryRingSize() const { return _sharedMemoryRingSize; }
+
+    // How the UDP, Unix socket and blocking HTTP transporters submit their
+    // sends. kIOUring falls back to plain sockets where the kernel lacks it.
+    utils::IOBackend ioBackend() const { return _ioBackend; }
+
     const Clock::duration& bufferFlushInterval() const
     {
         return _bufferFlushInterval;
@@ -111,6 +326,9 @@ class Config {
 
     bool logSpans() const { return _logSpans; }
 
+    // Host and port of the agent's UDP port, or "unix:///path" of its
+    // AF_UNIX datagram socket ("unixpacket:///path" for a seqpacket one),
+    // or "shm:///path" of a ring file polled by a consumer on this host.
     const std::string& localAgentHostPort() const
     {
         return _localAgentHostPort;
@@ -121,6 +339,15 @@ class Config {
       return _endpoint;
     }
 
+    // Number of spans each application thread collects before handing them
+    // to the reporter queue in one go; 0 reports every span directly.
+    int threadBufferSize() const { return _threadBufferSize; }
+
+    const Clock::duration& threadBufferMaxAge() const
+    {
+        return _threadBufferMaxAge;
+    }
+
     void fromEnv();
 
   private:
@@ -129,6 +356,23 @@ class Config {
     bool _logSpans;
     std::string _localAgentHostPort;
     std::string _endpoint;
+    int _threadBufferSize;
+    Clock::duration _threadBufferMaxAge;
+    size_t _queueSizeBytes;
+    OverflowPolicy _overflowPolicy;
+    Clock::duration _blockTimeout;
+    int _priorityQueueSize;
+    int _serializerThreads;
+    int _senderThreads;
+    int64_t _retryBufferSize;
+    int _udpPacketsPerSend;
+    int _httpMaxInFlight;
+    utils::Compression _compression;
+    int _compressionLevel;
+    int _httpChunkSize;
+    int _httpMaxBatchSize;
+    size_t _sharedMemoryRingSize;
+    utils::IOBackend _ioBackend;
 };
 
 }  // namespace reporters
@@ -20,6 +20,8 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include "jaegertracing/Logging.h"
+#include "jaegertracing/metrics/Metrics.h"
 #include "jaegertracing/reporters/Config.h"
 
 namespace jaegertracing {
@@ -34,6 +36,23 @@ TEST(Config, testLoadConfig)
         "    bufferFlushInterval: 88\n"
         "    localAgentHostPort: ahost:22\n"
         "    endpoint: http://somehost:33/api/traces\n"
+        "    threadBufferSize: 32\n"
+        "    threadBufferMaxAge: 50\n"
+        "    queueSizeBytes: 1048576\n"
+        "    overflowPolicy: drop-oldest\n"
+        "    blockTimeout: 250\n"
+        "    priorityQueueSize: 20\n"
+        "    serializerThreads: 2\n"
+        "    senderThreads: 3\n"
+        "    retryBufferSize: 262144\n"
+        "    udpPacketsPerSend: 8\n"
+        "    httpMaxInFlight: 4\n"
+        "    compression: gzip\n"
+        "    compressionLevel: 7\n"
+        "    httpChunkSize: 65536\n"
+        "    httpMaxBatchSize: 16777216\n"
+        "    sharedMemoryRingSize: 67108864\n"
+        "    ioBackend: io_uring\n"
         "sampler:\n"
         "  type: const\n"
         "  param: 1";
@@ -46,6 +65,64 @@ TEST(Config, testLoadConfig)
     ASSERT_EQ(std::chrono::seconds(88), config.bufferFlushInterval());
     ASSERT_EQ(std::string("ahost:22"), config.localAgentHostPort());
     ASSERT_EQ(std::string("http://somehost:33/api/traces"), config.endpoint());
+    ASSERT_EQ(32, config.threadBufferSize());
+    ASSERT_EQ(std::chrono::milliseconds(50), config.threadBufferMaxAge());
+    ASSERT_EQ(1048576u, config.queueSizeBytes());
+    ASSERT_EQ(OverflowPolicy::kDropOldest, config.overflowPolicy());
+    ASSERT_EQ(std::chrono::milliseconds(250), config.blockTimeout());
+    ASSERT_EQ(20, config.priorityQueueSize());
+    ASSERT_EQ(2, config.serializerThreads());
+    ASSERT_EQ(3, config.senderThreads());
+    ASSERT_EQ(262144, config.retryBufferSize());
+    ASSERT_EQ(8, config.udpPacketsPerSend());
+    ASSERT_EQ(4, config.httpMaxInFlight());
+    ASSERT_EQ(utils::Compressor::available(utils::Compression::kGzip)
+                  ? utils::Compression::kGzip
+                  : utils::Compression::kNone,
+              config.compression());
+    ASSERT_EQ(7, config.compressionLevel());
+    ASSERT_EQ(65536, config.httpChunkSize());
+    ASSERT_EQ(16777216, config.httpMaxBatchSize());
+    ASSERT_EQ(67108864u, config.sharedMemoryRingSize());
+#ifdef __linux__
+    ASSERT_EQ(utils::IOUring::available() ? utils::IOBackend::kIOUring
+                                          : utils::IOBackend::kSockets,
+              config.ioBackend());
+#else
+    ASSERT_EQ(utils::IOBackend::kSockets, config.ioBackend());
+#endif
+}
+
+TEST(Config, testMakeReporterWithCompression)
+{
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    // Codecs that are not built in fall back to uncompressed batches, and
+    // only HTTP transports compress.
+    for (auto compression :
+         { utils::Compression::kGzip, utils::Compression::kZstd }) {
+        for (auto endpoint : { "", "http://127.0.0.1:14268/api/traces" }) {
+            Config config(0,
+                          Config::defaultBufferFlushInterval(),
+                          false,
+                          "",
+                          endpoint,
+                          0,
+                          Config::defaultThreadBufferMaxAge(),
+                          0,
+                          OverflowPolicy::kDropNewest,
+                          Config::defaultBlockTimeout(),
+                          0,
+                          0,
+                          1,
+                          0,
+                          1,
+                          0,
+                          compression);
+            ASSERT_NO_THROW(
+                config.makeReporter("test-service", *logger, *metrics));
+        }
+    }
 }
 
 }  // namespace reporters
@@ -28,6 +28,8 @@ namespace reporters {
 
 class InMemoryReporter : public Reporter {
   public:
+    using Reporter::report;
+
     InMemoryReporter()
         : _spans()
         , _mutex()
@@ -25,6 +25,8 @@ namespace reporters {
 
 class LoggingReporter : public Reporter {
   public:
+    using Reporter::report;
+
     explicit LoggingReporter(logging::Logger& logger)
         : _logger(logger)
     {
@@ -28,6 +28,8 @@ namespace reporters {
 
 class NullReporter : public Reporter {
   public:
+    using Reporter::report;
+
     void report(const Span&) noexcept override {}
 
     void close() noexcept override {}
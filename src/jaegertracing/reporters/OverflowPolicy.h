@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_REPORTERS_OVERFLOWPOLICY_H
+#define JAEGERTRACING_REPORTERS_OVERFLOWPOLICY_H
+
+namespace jaegertracing {
+namespace reporters {
+
+// What RemoteReporter does with a span when its queue is full.
+enum class OverflowPolicy {
+    // Drop the span being reported.
+    kDropNewest,
+    // Evict the oldest queued span to make room.
+    kDropOldest,
+    // Wait up to a bounded timeout for the sweeper to make room, then drop
+    // the span being reported.
+    kBlock
+};
+
+}  // namespace reporters
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_REPORTERS_OVERFLOWPOLICY_H
@@ -16,6 +16,8 @@
 
 #include "jaegertracing/reporters/RemoteReporter.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <sstream>
 
@@ -28,41 +30,260 @@ RemoteReporter::RemoteReporter(const Clock::duration& bufferFlushInterval,
                                int fixedQueueSize,
                                std::unique_ptr<Sender>&& sender,
                                logging::Logger& logger,
-                               metrics::Metrics& metrics)
+                               metrics::Metrics& metrics,
+                               int threadBufferSize,
+                               const Clock::duration& threadBufferMaxAge,
+                               int64_t queueSizeBytes,
+                               OverflowPolicy overflowPolicy,
+                               const Clock::duration& blockTimeout,
+                               int priorityQueueSize,
+                               int serializerThreads,
+                               int senderThreads,
+                               const SenderFactory& senderFactory)
     : _bufferFlushInterval(bufferFlushInterval)
     , _fixedQueueSize(fixedQueueSize)
+    , _queueSizeBytes(queueSizeBytes)
+    , _overflowPolicy(overflowPolicy)
+    , _blockTimeout(blockTimeout)
     , _sender(std::move(sender))
+    , _pipeline()
     , _logger(logger)
     , _metrics(metrics)
-    , _queue()
+    , _queue(fixedQueueSize)
+    , _priorityQueue(priorityQueueSize > 0 ? new SpanQueue(priorityQueueSize)
+                                           : nullptr)
     , _queueLength(0)
+    , _queueBytes(0)
+    , _priorityQueueBytes(0)
+    , _sweeperWaiting(false)
+    , _blockedProducers(0)
+    , _staging()
     , _running(true)
     , _lastFlush(Clock::now())
     , _cv()
+    , _spaceCv()
     , _mutex()
     , _thread()
 {
+    if (threadBufferSize > 0) {
+        _staging.reset(new StagingBuffers(
+            threadBufferSize,
+            threadBufferMaxAge,
+            [this](StagingBuffers::SpanBatch& spans) { enqueue(spans); }));
+    }
+    if (serializerThreads > 0) {
+        std::vector<std::unique_ptr<Sender>> senders;
+        senders.push_back(std::move(_sender));
+        for (auto i = 1; i < senderThreads && senderFactory; ++i) {
+            auto extraSender = senderFactory();
+            if (extraSender) {
+                senders.push_back(std::move(extraSender));
+            }
+        }
+        _pipeline.reset(new SenderPipeline(serializerThreads,
+                                           std::move(senders),
+                                           bufferFlushInterval,
+                                           logger,
+                                           metrics));
+    }
     _thread = std::thread([this]() { sweepQueue(); });
 }
 
 void RemoteReporter::report(const Span& span) noexcept
 {
-    std::unique_lock<std::mutex> lock(_mutex);
-    const auto pushed = (static_cast<int>(_queue.size()) < _fixedQueueSize);
-    if (pushed) {
-        _queue.push_back(span);
-        lock.unlock();
-        _cv.notify_one();
-        ++_queueLength;
+    report(std::unique_ptr<Span>(new Span(span)));
+}
+
+void RemoteReporter::report(std::unique_ptr<Span>&& span) noexcept
+{
+    if (!span) {
+        return;
+    }
+    if (_staging) {
+        try {
+            _staging->add(std::move(span));
+        } catch (...) {
+            utils::ErrorUtil::logError(_logger,
+                                       "Failed to stage span in Reporter");
+        }
+        return;
+    }
+    if (enqueue(span, true)) {
+        wakeSweeper();
+    }
+}
+
+bool RemoteReporter::enqueue(std::unique_ptr<Span>& span,
+                             bool mayBlock) noexcept
+{
+    const auto size = static_cast<int64_t>(span->estimatedSize());
+    // Priority spans are counted apart from the byte budget, so that normal
+    // traffic cannot crowd them out nor they it; the lane's capacity bounds
+    // them instead.
+    const auto priority = _priorityQueue && span->context().isDebug();
+    if (priority && tryPush(*_priorityQueue, span, size, false)) {
+        return true;
+    }
+    if (tryPush(_queue, span, size, true)) {
+        return true;
+    }
+
+    auto queued = false;
+    auto* reason = &_metrics.reporterDroppedQueueFull();
+    switch (_overflowPolicy) {
+    case OverflowPolicy::kDropOldest: {
+        queued = evictAndPush(span, size);
+    } break;
+    case OverflowPolicy::kBlock: {
+        if (mayBlock) {
+            queued = waitAndPush(span, size);
+            reason = &_metrics.reporterDroppedTimeout();
+        }
+    } break;
+    default: {
+        assert(_overflowPolicy == OverflowPolicy::kDropNewest);
+    } break;
+    }
+    if (!queued) {
+        drop(priority ? _metrics.reporterDroppedPriority() : *reason, 1);
+    }
+    return queued;
+}
+
+bool RemoteReporter::tryPush(SpanQueue& queue,
+                             std::unique_ptr<Span>& span,
+                             int64_t size,
+                             bool withinBudget) noexcept
+{
+    if (withinBudget) {
+        if (!reserveQueueBytes(size)) {
+            return false;
+        }
     }
     else {
-        _metrics.reporterDropped().inc(1);
+        _priorityQueueBytes += size;
+    }
+    if (!queue.tryPush(std::move(span))) {
+        (withinBudget ? _queueBytes : _priorityQueueBytes) -= size;
+        return false;
+    }
+    ++_queueLength;
+    return true;
+}
+
+bool RemoteReporter::evictAndPush(std::unique_ptr<Span>& span,
+                                  int64_t size) noexcept
+{
+    if (_queueSizeBytes > 0 && size > _queueSizeBytes) {
+        // Evicting everything would not make room for it.
+        return false;
+    }
+    std::unique_ptr<Span> oldest;
+    for (auto i = 0; i < _fixedQueueSize; ++i) {
+        if (!_queue.tryPop(oldest)) {
+            return false;
+        }
+        _queueBytes -= static_cast<int64_t>(oldest->estimatedSize());
+        --_queueLength;
+        oldest.reset();
+        drop(_metrics.reporterDroppedEvicted(), 1);
+        if (tryPush(_queue, span, size, true)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RemoteReporter::waitAndPush(std::unique_ptr<Span>& span,
+                                 int64_t size) noexcept
+{
+    try {
+        const auto deadline = Clock::now() + _blockTimeout;
+        std::unique_lock<std::mutex> lock(_mutex);
+        // Pairs with the fence in notifyBlockedProducers().
+        ++_blockedProducers;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto queued = tryPush(_queue, span, size, true);
+        while (!queued && _running &&
+               _spaceCv.wait_until(lock, deadline) ==
+                   std::cv_status::no_timeout) {
+            queued = tryPush(_queue, span, size, true);
+        }
+        --_blockedProducers;
+        return queued;
+    } catch (...) {
+        utils::ErrorUtil::logError(_logger,
+                                   "Failed waiting for space in Reporter");
+        return false;
+    }
+}
+
+void RemoteReporter::drop(metrics::Counter& reason, int64_t count) noexcept
+{
+    _metrics.reporterDropped().inc(count);
+    reason.inc(count);
+}
+
+bool RemoteReporter::reserveQueueBytes(int64_t size) noexcept
+{
+    const auto queued = (_queueBytes += size);
+    if (_queueSizeBytes > 0 && queued > _queueSizeBytes) {
+        _queueBytes -= size;
+        return false;
+    }
+    return true;
+}
+
+void RemoteReporter::enqueue(StagingBuffers::SpanBatch& spans) noexcept
+{
+    // Admit the longest prefix of the batch that fits in the byte budget.
+    auto last = spans.begin();
+    for (; last != spans.end(); ++last) {
+        if (!reserveQueueBytes(
+                static_cast<int64_t>((*last)->estimatedSize()))) {
+            break;
+        }
+    }
+    const auto pushed = _queue.tryPushBatch(spans.begin(), last);
+    for (auto itr = spans.begin() + pushed; itr != last; ++itr) {
+        _queueBytes -= static_cast<int64_t>((*itr)->estimatedSize());
+    }
+    _queueLength += static_cast<int>(pushed);
+
+    // Anything left over goes through the overflow policy one by one. Staged
+    // spans are handed off while holding buffer locks the sweeper may need,
+    // so they never block.
+    auto queued = pushed;
+    for (auto itr = spans.begin() + pushed; itr != spans.end(); ++itr) {
+        if (enqueue(*itr, false)) {
+            ++queued;
+        }
+    }
+    if (queued > 0) {
+        wakeSweeper();
+    }
+}
+
+void RemoteReporter::wakeSweeper() noexcept
+{
+    // Pairs with the fence in sweepQueue(): either the sweeper sees the span
+    // that was just pushed, or we see that it is about to sleep and wake it.
+    // Producers only take the mutex while the sweeper is idle.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sweeperWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cv.notify_one();
     }
 }
 
 void RemoteReporter::close() noexcept
 {
     try {
+        // Hand staged spans over before the sweeper is told to finish, so
+        // its last sweep picks them up.
+        if (_staging) {
+            _staging->close();
+        }
         {
             std::lock_guard<std::mutex> lock(_mutex);
             if (!_running) {
@@ -71,8 +292,12 @@ void RemoteReporter::close() noexcept
             _running = false;
         }
         _cv.notify_one();
+        _spaceCv.notify_all();
         _thread.join();
         flush();
+        if (_pipeline) {
+            _pipeline->close();
+        }
     } catch (...) {
         utils::ErrorUtil::logError(_logger, "Failed in Reporter::close");
     }
@@ -80,26 +305,57 @@ void RemoteReporter::close() noexcept
 
 void RemoteReporter::sweepQueue() noexcept
 {
+    std::vector<std::unique_ptr<Span>> batch;
     while (true) {
         try {
-            std::unique_lock<std::mutex> lock(_mutex);
-            _cv.wait_until(lock, _lastFlush + _bufferFlushInterval, [this]() {
-                return !_running || !_queue.empty();
-            });
+            auto running = true;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _sweeperWaiting = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                _cv.wait_until(lock, nextWakeup(), [this]() {
+                    return !_running || !queuesEmpty();
+                });
+                _sweeperWaiting = false;
+                running = _running;
+            }
 
-            if (!_running && _queue.empty()) {
-                return;
+            if (_staging && running) {
+                _staging->handOffStale();
             }
 
-            if (!_queue.empty()) {
-                const auto span = _queue.front();
-                _queue.pop_front();
-                --_queueLength;
-                sendSpan(span);
+            // Take everything queued so far and hand it to the sender with
+            // the mutex released, so neither report() nor close() wait on
+            // serialization or network I/O.
+            drainQueue(batch);
+            _metrics.reporterQueueLength().update(_queueLength);
+            _metrics.reporterQueueBytes().update(_queueBytes +
+                                                 _priorityQueueBytes);
+            if (!batch.empty()) {
+                notifyBlockedProducers();
+                if (_pipeline) {
+                    _pipeline->submit(batch);
+                }
+                else {
+                    for (auto&& span : batch) {
+                        sendSpan(*span);
+                    }
+                    batch.clear();
+                }
+                if (bufferFlushIntervalExpired()) {
+                    flush();
+                }
+            }
+            else if (!running && queuesEmpty()) {
+                return;
             }
             else if (bufferFlushIntervalExpired()) {
                 flush();
             }
+            else {
+                // A producer claimed a slot but has not filled it yet.
+                std::this_thread::yield();
+            }
         } catch (...) {
             utils::ErrorUtil::logError(_logger,
                                        "Failed in Reporter::sweepQueue");
@@ -107,16 +363,67 @@ void RemoteReporter::sweepQueue() noexcept
     }
 }
 
+RemoteReporter::Clock::time_point RemoteReporter::nextWakeup() const
+{
+    const auto flushTime = _lastFlush + _bufferFlushInterval;
+    if (!_staging) {
+        return flushTime;
+    }
+    // Wake up often enough to collect spans from threads that stopped
+    // reporting before filling their buffer.
+    return std::min(flushTime, Clock::now() + _staging->maxAge());
+}
+
+void RemoteReporter::drainQueue(std::vector<std::unique_ptr<Span>>& batch)
+{
+    // Bound each sweep by the queue capacities so a steady stream of
+    // producers cannot keep the sweeper from flushing. Priority spans go out
+    // first.
+    if (_priorityQueue) {
+        drainQueue(*_priorityQueue,
+                   static_cast<int>(_priorityQueue->capacity()),
+                   _priorityQueueBytes,
+                   batch);
+    }
+    drainQueue(_queue, _fixedQueueSize, _queueBytes, batch);
+}
+
+void RemoteReporter::drainQueue(SpanQueue& queue,
+                                int limit,
+                                std::atomic<int64_t>& queueBytes,
+                                std::vector<std::unique_ptr<Span>>& batch)
+{
+    std::unique_ptr<Span> span;
+    for (auto i = 0; i < limit && queue.tryPop(span); ++i) {
+        queueBytes -= static_cast<int64_t>(span->estimatedSize());
+        batch.push_back(std::move(span));
+        --_queueLength;
+    }
+}
+
+void RemoteReporter::notifyBlockedProducers() noexcept
+{
+    // Pairs with the fence in waitAndPush(): either the producer sees the
+    // room that was just made, or we see it waiting and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_blockedProducers.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _spaceCv.notify_all();
+    }
+}
+
 void RemoteReporter::sendSpan(const Span& span) noexcept
 {
     try {
         const auto flushed = _sender->append(span);
         if (flushed > 0) {
             _metrics.reporterSuccess().inc(flushed);
-            _metrics.reporterQueueLength().update(_queueLength);
         }
     } catch (const Sender::Exception& ex) {
         _metrics.reporterFailure().inc(ex.numFailed());
+        if (ex.numSent() > 0) {
+            _metrics.reporterSuccess().inc(ex.numSent());
+        }
         std::ostringstream oss;
         oss << "error reporting span " << span.operationName() << ": "
             << ex.what();
@@ -126,14 +433,20 @@ void RemoteReporter::sendSpan(const Span& span) noexcept
 
 void RemoteReporter::flush() noexcept
 {
-    try {
-        const auto flushed = _sender->flush();
-        if (flushed > 0) {
-            _metrics.reporterSuccess().inc(flushed);
+    // With a pipeline, each sender thread flushes its own sender.
+    if (!_pipeline) {
+        try {
+            const auto flushed = _sender->flush();
+            if (flushed > 0) {
+                _metrics.reporterSuccess().inc(flushed);
+            }
+        } catch (const Sender::Exception& ex) {
+            _metrics.reporterFailure().inc(ex.numFailed());
+            if (ex.numSent() > 0) {
+                _metrics.reporterSuccess().inc(ex.numSent());
+            }
+            _logger.error(ex.what());
         }
-    } catch (const Sender::Exception& ex) {
-        _metrics.reporterFailure().inc(ex.numFailed());
-        _logger.error(ex.what());
     }
 
     _lastFlush = Clock::now();
@@ -19,9 +19,12 @@
 
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "jaegertracing/Compilers.h"
 
@@ -29,7 +32,11 @@
 #include "jaegertracing/Span.h"
 #include "jaegertracing/Sender.h"
 #include "jaegertracing/metrics/Metrics.h"
+#include "jaegertracing/reporters/OverflowPolicy.h"
 #include "jaegertracing/reporters/Reporter.h"
+#include "jaegertracing/reporters/SenderPipeline.h"
+#include "jaegertracing/reporters/StagingBuffers.h"
+#include "jaegertracing/utils/RingBuffer.h"
 
 namespace jaegertracing {
 namespace reporters {
@@ -37,24 +44,72 @@ namespace reporters {
 class RemoteReporter : public Reporter {
   public:
     using Clock = std::chrono::steady_clock;
+    using SenderFactory = std::function<std::unique_ptr<Sender>()>;
 
     RemoteReporter(const Clock::duration& bufferFlushInterval,
                    int fixedQueueSize,
                    std::unique_ptr<Sender>&& sender,
                    logging::Logger& logger,
-                   metrics::Metrics& metrics);
+                   metrics::Metrics& metrics,
+                   int threadBufferSize = 0,
+                   const Clock::duration& threadBufferMaxAge =
+                       Clock::duration(),
+                   int64_t queueSizeBytes = 0,
+                   OverflowPolicy overflowPolicy = OverflowPolicy::kDropNewest,
+                   const Clock::duration& blockTimeout = Clock::duration(),
+                   int priorityQueueSize = 0,
+                   int serializerThreads = 0,
+                   int senderThreads = 1,
+                   const SenderFactory& senderFactory = SenderFactory());
 
     ~RemoteReporter() { close(); }
 
     void report(const Span& span) noexcept override;
 
+    void report(std::unique_ptr<Span>&& span) noexcept override;
+
     void close() noexcept override;
 
   private:
+    using SpanQueue = utils::RingBuffer<std::unique_ptr<Span>>;
+
     void sweepQueue() noexcept;
 
+    void enqueue(StagingBuffers::SpanBatch& spans) noexcept;
+
+    bool enqueue(std::unique_ptr<Span>& span, bool mayBlock) noexcept;
+
+    bool tryPush(SpanQueue& queue,
+                 std::unique_ptr<Span>& span,
+                 int64_t size,
+                 bool withinBudget) noexcept;
+
+    bool evictAndPush(std::unique_ptr<Span>& span, int64_t size) noexcept;
+
+    bool waitAndPush(std::unique_ptr<Span>& span, int64_t size) noexcept;
+
+    bool reserveQueueBytes(int64_t size) noexcept;
+
+    void drop(metrics::Counter& reason, int64_t count) noexcept;
+
+    bool queuesEmpty() const
+    {
+        return _queue.empty() && (!_priorityQueue || _priorityQueue->empty());
+    }
+
+    void notifyBlockedProducers() noexcept;
+
+    void drainQueue(std::vector<std::unique_ptr<Span>>& batch);
+
+    void drainQueue(SpanQueue& queue,
+                    int limit,
+                    std::atomic<int64_t>& queueBytes,
+                    std::vector<std::unique_ptr<Span>>& batch);
+
     void sendSpan(const Span& span) noexcept;
 
+    void wakeSweeper() noexcept;
+
     void flush() noexcept;
 
     bool bufferFlushIntervalExpired() const
@@ -62,16 +117,30 @@ class RemoteReporter : public Reporter {
         return (Clock::now() - _lastFlush) >= _bufferFlushInterval;
     }
 
+    Clock::time_point nextWakeup() const;
+
     Clock::duration _bufferFlushInterval;
     int _fixedQueueSize;
+    int64_t _queueSizeBytes;
+    OverflowPolicy _overflowPolicy;
+    Clock::duration _blockTimeout;
     std::unique_ptr<Sender> _sender;
+    std::unique_ptr<SenderPipeline> _pipeline;
     logging::Logger& _logger;
     metrics::Metrics& _metrics;
-    std::deque<Span> _queue;
+    SpanQueue _queue;
+    std::unique_ptr<SpanQueue> _priorityQueue;
     std::atomic<int> _queueLength;
+    // Bytes held by the normal queue, bounded by _queueSizeBytes.
+    std::atomic<int64_t> _queueBytes;
+    std::atomic<int64_t> _priorityQueueBytes;
+    std::atomic<bool> _sweeperWaiting;
+    std::atomic<int> _blockedProducers;
+    std::unique_ptr<StagingBuffers> _staging;
     bool _running;
     Clock::time_point _lastFlush;
     std::condition_variable _cv;
+    std::condition_variable _spaceCv;
     std::mutex _mutex;
     std::thread _thread;
 };
@@ -15,3 +15,17 @@
  */
 
 #include "jaegertracing/reporters/Reporter.h"
+#include "jaegertracing/Span.h"
+
+namespace jaegertracing {
+namespace reporters {
+
+void Reporter::report(std::unique_ptr<Span>&& span) noexcept
+{
+    if (span) {
+        report(*span);
+    }
+}
+
+}  // namespace reporters
+}  // namespace jaegertracing
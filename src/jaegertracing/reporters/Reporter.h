@@ -17,6 +17,8 @@
 #ifndef JAEGERTRACING_REPORTERS_REPORTER_H
 #define JAEGERTRACING_REPORTERS_REPORTER_H
 
+#include <memory>
+
 #include "jaegertracing/Compilers.h"
 
 namespace jaegertracing {
@@ -31,6 +33,11 @@ class Reporter {
 
     virtual void report(const Span& span) noexcept = 0;
 
+    // Reports a finished span whose data the caller no longer needs. The
+    // default forwards to report(const Span&); reporters that keep spans
+    // around should override it to take ownership instead of copying.
+    virtual void report(std::unique_ptr<Span>&& span) noexcept;
+
     virtual void close() noexcept = 0;
 };
 
@@ -16,9 +16,12 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+
 #include "jaegertracing/Logging.h"
 #include "jaegertracing/Tracer.h"
 #include "jaegertracing/Sender.h"
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
 #include "jaegertracing/reporters/CompositeReporter.h"
 #include "jaegertracing/reporters/InMemoryReporter.h"
 #include "jaegertracing/reporters/LoggingReporter.h"
@@ -54,8 +57,47 @@ class FakeTransport : public Sender {
     std::mutex& _mutex;
 };
 
+class BlockingTransport : public Sender {
+  public:
+    BlockingTransport(const std::shared_future<void>& released,
+                      std::atomic<int>& count)
+        : _released(released)
+        , _count(count)
+        , _waiting(false)
+    {
+    }
+
+    bool waiting() const { return _waiting; }
+
+    int append(const Span&) override
+    {
+        _waiting = true;
+        _released.wait();
+        ++_count;
+        return 1;
+    }
+
+    int flush() override { return 0; }
+
+    void close() override {}
+
+  private:
+    std::shared_future<void> _released;
+    std::atomic<int>& _count;
+    std::atomic<bool> _waiting;
+};
+
 const Span span;
 
+int64_t droppedCount(const metrics::InMemoryStatsReporter& stats,
+                     const std::string& reason)
+{
+    const auto itr = stats.counters().find(
+        metrics::Metrics::addTagsToMetricName("jaeger.reporter-dropped",
+                                              { { "reason", reason } }));
+    return (itr == std::end(stats.counters())) ? 0 : itr->second;
+}
+
 }  // anonymous namespace
 
 TEST(Reporter, testRemoteReporter)
@@ -81,6 +123,415 @@ TEST(Reporter, testRemoteReporter)
     ASSERT_EQ(spans.size(), kNumReports);
 }
 
+TEST(Reporter, testRemoteReporterSlowSender)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    constexpr auto kFixedQueueSize = 20;
+    RemoteReporter reporter(
+        std::chrono::milliseconds(1),
+        kFixedQueueSize,
+        std::unique_ptr<Sender>(
+            new BlockingTransport(release.get_future().share(), count)),
+        *logger,
+        *metrics);
+    // While the sender is stuck in append(), reporting must not block.
+    constexpr auto kNumReports = 10;
+    for (auto i = 0; i < kNumReports; ++i) {
+        reporter.report(span);
+    }
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(kNumReports, count.load());
+}
+
+TEST(Reporter, testRemoteReporterQueueSizeBytes)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    const Span largeSpan(nullptr,
+                         SpanContext(),
+                         "large",
+                         Span::SystemClock::now(),
+                         Span::SteadyClock::now(),
+                         { Tag("payload", std::string(4096, 'x')) });
+    const auto spanSize = static_cast<int64_t>(largeSpan.estimatedSize());
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            100,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            3 * spanSize + spanSize / 2);
+
+    // Hold the sender so that queued spans stay queued.
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+
+    // The queue has room for 100 spans but only 3 fit in the byte budget.
+    for (auto i = 0; i < 10; ++i) {
+        reporter.report(largeSpan);
+    }
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(4, count.load());
+}
+
+TEST(Reporter, testRemoteReporterDropOldest)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            3,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            0,
+                            OverflowPolicy::kDropOldest);
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+
+    for (auto i = 0; i < 5; ++i) {
+        reporter.report(span);
+    }
+    ASSERT_EQ(2, droppedCount(stats, "evicted"));
+    ASSERT_EQ(0, droppedCount(stats, "queue-full"));
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(4, count.load());
+}
+
+TEST(Reporter, testRemoteReporterBlock)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            2,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            0,
+                            OverflowPolicy::kBlock,
+                            std::chrono::seconds(10));
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+    reporter.report(span);
+    reporter.report(span);
+
+    // The queue is full, so this report waits until the sender catches up.
+    std::thread producer([&reporter]() { reporter.report(span); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    release.set_value();
+    producer.join();
+    reporter.close();
+    ASSERT_EQ(4, count.load());
+    ASSERT_EQ(0, droppedCount(stats, "timeout"));
+}
+
+TEST(Reporter, testRemoteReporterBlockTimeout)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            1,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            0,
+                            OverflowPolicy::kBlock,
+                            std::chrono::milliseconds(10));
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+    reporter.report(span);
+    reporter.report(span);
+    ASSERT_EQ(1, droppedCount(stats, "timeout"));
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(2, count.load());
+}
+
+TEST(Reporter, testRemoteReporterPriorityQueue)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            1,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            0,
+                            OverflowPolicy::kDropNewest,
+                            RemoteReporter::Clock::duration(),
+                            2);
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+
+    // Normal traffic is shed once the queue is full...
+    reporter.report(span);
+    reporter.report(span);
+    ASSERT_EQ(1, droppedCount(stats, "queue-full"));
+
+    // ...while debug spans still get through the priority lane.
+    const Span debugSpan(
+        nullptr,
+        SpanContext(TraceID(1, 2),
+                    3,
+                    0,
+                    static_cast<unsigned char>(SpanContext::Flag::kSampled) |
+                        static_cast<unsigned char>(SpanContext::Flag::kDebug),
+                    SpanContext::StrMap()));
+    for (auto i = 0; i < 3; ++i) {
+        reporter.report(debugSpan);
+    }
+    ASSERT_EQ(1, droppedCount(stats, "priority"));
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(4, count.load());
+}
+
+TEST(Reporter, testRemoteReporterPriorityQueueBytes)
+{
+    std::promise<void> release;
+    std::atomic<int> count(0);
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    const std::vector<Tag> tags = { Tag("payload", std::string(4096, 'x')) };
+    const Span largeSpan(nullptr,
+                         SpanContext(),
+                         "large",
+                         Span::SystemClock::now(),
+                         Span::SteadyClock::now(),
+                         tags);
+    const Span largeDebugSpan(
+        nullptr,
+        SpanContext(TraceID(1, 2),
+                    3,
+                    0,
+                    static_cast<unsigned char>(SpanContext::Flag::kSampled) |
+                        static_cast<unsigned char>(SpanContext::Flag::kDebug),
+                    SpanContext::StrMap()),
+        "large",
+        Span::SystemClock::now(),
+        Span::SteadyClock::now(),
+        tags);
+    const auto spanSize = static_cast<int64_t>(largeSpan.estimatedSize());
+    auto transport =
+        new BlockingTransport(release.get_future().share(), count);
+    RemoteReporter reporter(std::chrono::hours(1),
+                            3,
+                            std::unique_ptr<Sender>(transport),
+                            *logger,
+                            *metrics,
+                            0,
+                            RemoteReporter::Clock::duration(),
+                            2 * spanSize + spanSize / 2,
+                            OverflowPolicy::kDropOldest,
+                            RemoteReporter::Clock::duration(),
+                            4);
+    reporter.report(span);
+    while (!transport->waiting()) {
+        std::this_thread::yield();
+    }
+
+    // The priority lane holds more than the byte budget...
+    for (auto i = 0; i < 3; ++i) {
+        reporter.report(largeDebugSpan);
+    }
+    // ...which leaves the budget of the normal queue untouched.
+    reporter.report(largeSpan);
+    reporter.report(largeSpan);
+    ASSERT_EQ(0, droppedCount(stats, "evicted"));
+    ASSERT_EQ(0, droppedCount(stats, "queue-full"));
+
+    // Only normal spans are evicted to make room.
+    reporter.report(largeSpan);
+    ASSERT_EQ(1, droppedCount(stats, "evicted"));
+    ASSERT_EQ(0, droppedCount(stats, "queue-full"));
+    release.set_value();
+    reporter.close();
+    ASSERT_EQ(6, count.load());
+}
+
+TEST(Reporter, testRemoteReporterThreadBuffers)
+{
+    std::vector<Span> spans;
+    std::mutex mutex;
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    constexpr auto kFixedQueueSize = 1000;
+    constexpr auto kThreadBufferSize = 64;
+    RemoteReporter reporter(
+        std::chrono::milliseconds(1),
+        kFixedQueueSize,
+        std::unique_ptr<Sender>(new FakeTransport(spans, mutex)),
+        *logger,
+        *metrics,
+        kThreadBufferSize,
+        std::chrono::hours(1));
+
+    // Partially filled buffers are handed off when their thread exits.
+    constexpr auto kNumThreads = 4;
+    constexpr auto kNumReports = 100;
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&reporter]() {
+            for (auto j = 0; j < kNumReports; ++j) {
+                reporter.report(span);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    // And on close for threads that are still running.
+    constexpr auto kNumLateReports = 10;
+    for (auto i = 0; i < kNumLateReports; ++i) {
+        reporter.report(span);
+    }
+    reporter.close();
+    ASSERT_EQ(kNumThreads * kNumReports + kNumLateReports,
+              static_cast<int>(spans.size()));
+}
+
+TEST(Reporter, testRemoteReporterThreadBufferMaxAge)
+{
+    std::vector<Span> spans;
+    std::mutex mutex;
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    RemoteReporter reporter(
+        std::chrono::milliseconds(1),
+        10,
+        std::unique_ptr<Sender>(new FakeTransport(spans, mutex)),
+        *logger,
+        *metrics,
+        64,
+        std::chrono::milliseconds(10));
+    reporter.report(span);
+
+    // The sweeper collects the span once it is older than the age limit.
+    auto sent = false;
+    for (auto i = 0; i < 500 && !sent; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::lock_guard<std::mutex> lock(mutex);
+        sent = !spans.empty();
+    }
+    ASSERT_TRUE(sent);
+    reporter.close();
+}
+
+TEST(Reporter, testRemoteReporterPipeline)
+{
+    std::vector<Span> spans;
+    std::mutex mutex;
+    auto senders = 1;
+    auto logger = logging::nullLogger();
+    auto metrics = metrics::Metrics::makeNullMetrics();
+    RemoteReporter reporter(
+        std::chrono::milliseconds(1),
+        1000,
+        std::unique_ptr<Sender>(new FakeTransport(spans, mutex)),
+        *logger,
+        *metrics,
+        0,
+        RemoteReporter::Clock::duration(),
+        0,
+        OverflowPolicy::kBlock,
+        std::chrono::seconds(10),
+        0,
+        2,
+        2,
+        [&spans, &mutex, &senders]() {
+            ++senders;
+            return std::unique_ptr<Sender>(new FakeTransport(spans, mutex));
+        });
+    ASSERT_EQ(2, senders);
+
+    constexpr auto kNumReports = 1000;
+    for (auto i = 0; i < kNumReports; ++i) {
+        reporter.report(span);
+    }
+    reporter.close();
+    ASSERT_EQ(kNumReports, spans.size());
+}
+
+TEST(Reporter, testRemoteReporterPipelineQueueGauges)
+{
+    std::vector<Span> spans;
+    std::mutex mutex;
+    auto logger = logging::nullLogger();
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    RemoteReporter reporter(
+        std::chrono::milliseconds(1),
+        100,
+        std::unique_ptr<Sender>(new FakeTransport(spans, mutex)),
+        *logger,
+        *metrics,
+        0,
+        RemoteReporter::Clock::duration(),
+        0,
+        OverflowPolicy::kBlock,
+        std::chrono::seconds(10),
+        0,
+        1);
+    for (auto i = 0; i < 10; ++i) {
+        reporter.report(span);
+    }
+    reporter.close();
+    ASSERT_EQ(10, spans.size());
+    // The sweeper updates the gauges even though it sends nothing itself.
+    ASSERT_EQ(0, stats.gauges().at("jaeger.reporter-queue"));
+    ASSERT_EQ(0, stats.gauges().at("jaeger.reporter-queue-bytes"));
+}
+
 TEST(Reporter, testNullReporter)
 {
     NullReporter reporter;
@@ -131,5 +582,15 @@ TEST(Reporter, testCompositeReporter)
                   ->spansSubmitted());
 }
 
+TEST(Reporter, testCompositeReporterTransfersSpan)
+{
+    auto first = std::make_shared<InMemoryReporter>();
+    auto second = std::make_shared<InMemoryReporter>();
+    CompositeReporter reporter({ first, second });
+    reporter.report(std::unique_ptr<Span>(new Span()));
+    ASSERT_EQ(1, first->spansSubmitted());
+    ASSERT_EQ(1, second->spansSubmitted());
+}
+
 }  // namespace reporters
 }  // namespace jaegertracing
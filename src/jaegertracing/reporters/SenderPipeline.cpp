@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/reporters/SenderPipeline.h"
+
+#include <cassert>
+#include <sstream>
+
+#include "jaegertracing/utils/ErrorUtil.h"
+
+namespace jaegertracing {
+namespace reporters {
+
+SenderPipeline::SenderPipeline(int serializerThreads,
+                               std::vector<std::unique_ptr<Sender>>&& senders,
+                               const Clock::duration& bufferFlushInterval,
+                               logging::Logger& logger,
+                               metrics::Metrics& metrics)
+    : _senders(std::move(senders))
+    , _bufferFlushInterval(bufferFlushInterval)
+    , _logger(logger)
+    , _metrics(metrics)
+    , _spans(2 * serializerThreads)
+    , _serialized(2 * _senders.size())
+    , _serializerThreads()
+    , _senderThreads()
+    , _closeMutex()
+    , _closed(false)
+{
+    assert(!_senders.empty());
+    for (auto i = 0; i < serializerThreads; ++i) {
+        _serializerThreads.emplace_back([this]() { serialize(); });
+    }
+    for (auto&& sender : _senders) {
+        auto* senderPtr = sender.get();
+        _senderThreads.emplace_back([this, senderPtr]() { send(*senderPtr); });
+    }
+}
+
+void SenderPipeline::submit(SpanBatch& spans)
+{
+    SpanBatch batch;
+    batch.swap(spans);
+    _spans.push(std::move(batch));
+}
+
+void SenderPipeline::close() noexcept
+{
+    try {
+        std::lock_guard<std::mutex> lock(_closeMutex);
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+
+        // Let each stage finish what it has before closing the next one.
+        _spans.close();
+        for (auto&& thread : _serializerThreads) {
+            thread.join();
+        }
+        _serialized.close();
+        for (auto&& thread : _senderThreads) {
+            thread.join();
+        }
+    } catch (...) {
+        utils::ErrorUtil::logError(_logger, "Failed in SenderPipeline::close");
+    }
+}
+
+void SenderPipeline::serialize() noexcept
+{
+    // All senders are of the same type, and serialize() may be called from
+    // any thread, so the first one serves all serializers.
+    const auto& serializer = *_senders.front();
+    SpanBatch spans;
+    while (_spans.pop(spans)) {
+        SerializedBatch batch;
+        batch.reserve(spans.size());
+        for (auto&& span : spans) {
+            try {
+                batch.push_back(serializer.serialize(std::move(span)));
+            } catch (...) {
+                _metrics.reporterFailure().inc(1);
+                utils::ErrorUtil::logError(_logger,
+                                           "Failed to serialize span");
+            }
+        }
+        spans.clear();
+        _serialized.push(std::move(batch));
+    }
+}
+
+void SenderPipeline::send(Sender& sender) noexcept
+{
+    auto lastFlush = Clock::now();
+    SerializedBatch batch;
+    while (true) {
+        const auto popped =
+            _serialized.pop(batch, lastFlush + _bufferFlushInterval);
+        for (auto&& span : batch) {
+            append(sender, std::move(span));
+        }
+        batch.clear();
+
+        const auto done = !popped && _serialized.done();
+        if (done || Clock::now() - lastFlush >= _bufferFlushInterval) {
+            flush(sender);
+            lastFlush = Clock::now();
+        }
+        if (done) {
+            return;
+        }
+    }
+}
+
+void SenderPipeline::append(
+    Sender& sender, std::unique_ptr<Sender::SerializedSpan>&& span) noexcept
+{
+    try {
+        const auto flushed = sender.appendSerialized(std::move(span));
+        if (flushed > 0) {
+            _metrics.reporterSuccess().inc(flushed);
+        }
+    } catch (const Sender::Exception& ex) {
+        _metrics.reporterFailure().inc(ex.numFailed());
+        if (ex.numSent() > 0) {
+            _metrics.reporterSuccess().inc(ex.numSent());
+        }
+        std::ostringstream oss;
+        oss << "error reporting span: " << ex.what();
+        _logger.error(oss.str());
+    } catch (...) {
+        _metrics.reporterFailure().inc(1);
+        utils::ErrorUtil::logError(_logger, "Failed to append span");
+    }
+}
+
+void SenderPipeline::flush(Sender& sender) noexcept
+{
+    try {
+        const auto flushed = sender.flush();
+        if (flushed > 0) {
+            _metrics.reporterSuccess().inc(flushed);
+        }
+    } catch (const Sender::Exception& ex) {
+        _metrics.reporterFailure().inc(ex.numFailed());
+        if (ex.numSent() > 0) {
+            _metrics.reporterSuccess().inc(ex.numSent());
+        }
+        _logger.error(ex.what());
+    } catch (...) {
+        utils::ErrorUtil::logError(_logger, "Failed to flush sender");
+    }
+}
+
+}  // namespace reporters
+}  // namespace jaegertracing
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_REPORTERS_SENDERPIPELINE_H
+#define JAEGERTRACING_REPORTERS_SENDERPIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "jaegertracing/Logging.h"
+#include "jaegertracing/Sender.h"
+#include "jaegertracing/Span.h"
+#include "jaegertracing/metrics/Metrics.h"
+
+namespace jaegertracing {
+namespace reporters {
+
+// Moves the work of RemoteReporter's sweeper onto worker threads: serializer
+// threads convert batches of spans with Sender::serialize(), and one thread
+// per sender appends the results and flushes its sender. Each sender thread
+// owns its sender, so senders are never shared between threads.
+class SenderPipeline {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using SpanBatch = std::vector<std::unique_ptr<Span>>;
+
+    SenderPipeline(int serializerThreads,
+                   std::vector<std::unique_ptr<Sender>>&& senders,
+                   const Clock::duration& bufferFlushInterval,
+                   logging::Logger& logger,
+                   metrics::Metrics& metrics);
+
+    ~SenderPipeline() { close(); }
+
+    SenderPipeline(const SenderPipeline&) = delete;
+
+    SenderPipeline& operator=(const SenderPipeline&) = delete;
+
+    // Takes all spans out of `spans`. Blocks while the serializers are
+    // behind, which in turn lets the reporter queue apply its overflow
+    // policy.
+    void submit(SpanBatch& spans);
+
+    // Sends everything submitted so far, flushes the senders and stops the
+    // workers.
+    void close() noexcept;
+
+  private:
+    using SerializedBatch =
+        std::vector<std::unique_ptr<Sender::SerializedSpan>>;
+
+    // Bounded blocking queue between two stages.
+    template <typename ValueType>
+    class Channel {
+      public:
+        explicit Channel(size_t capacity)
+            : _capacity(capacity > 0 ? capacity : 1)
+            , _closed(false)
+        {
+        }
+
+        bool push(ValueType&& value)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notFull.wait(lock, [this]() {
+                return _closed || _values.size() < _capacity;
+            });
+            if (_closed) {
+                return false;
+            }
+            _values.push_back(std::move(value));
+            _notEmpty.notify_one();
+            return true;
+        }
+
+        // Returns false once the channel is closed and empty.
+        bool pop(ValueType& value)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock,
+                           [this]() { return _closed || !_values.empty(); });
+            return popNoLock(value);
+        }
+
+        // Also returns false if nothing arrived before `deadline`.
+        bool pop(ValueType& value, const Clock::time_point& deadline)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait_until(lock, deadline, [this]() {
+                return _closed || !_values.empty();
+            });
+            return popNoLock(value);
+        }
+
+        bool done() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _closed && _values.empty();
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+            _notEmpty.notify_all();
+            _notFull.notify_all();
+        }
+
+      private:
+        bool popNoLock(ValueType& value)
+        {
+            if (_values.empty()) {
+                return false;
+            }
+            value = std::move(_values.front());
+            _values.pop_front();
+            _notFull.notify_one();
+            return true;
+        }
+
+        const size_t _capacity;
+        std::deque<ValueType> _values;
+        bool _closed;
+        mutable std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+    };
+
+    void serialize() noexcept;
+
+    void send(Sender& sender) noexcept;
+
+    void append(Sender& sender,
+                std::unique_ptr<Sender::SerializedSpan>&& span) noexcept;
+
+    void flush(Sender& sender) noexcept;
+
+    std::vector<std::unique_ptr<Sender>> _senders;
+    Clock::duration _bufferFlushInterval;
+    logging::Logger& _logger;
+    metrics::Metrics& _metrics;
+    Channel<SpanBatch> _spans;
+    Channel<SerializedBatch> _serialized;
+    std::vector<std::thread> _serializerThreads;
+    std::vector<std::thread> _senderThreads;
+    std::mutex _closeMutex;
+    bool _closed;
+};
+
+}  // namespace reporters
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_REPORTERS_SENDERPIPELINE_H
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/reporters/StagingBuffers.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "jaegertracing/Span.h"
+
+namespace jaegertracing {
+namespace reporters {
+namespace {
+
+std::atomic<uint64_t> nextId(0);
+
+}  // anonymous namespace
+
+// The buffers of one thread, at most one per StagingBuffers instance. Entries
+// are keyed by id rather than address since an instance may be destroyed and
+// another one allocated at the same address.
+class StagingBuffers::ThreadBuffers {
+  public:
+    ~ThreadBuffers()
+    {
+        for (auto&& entry : _entries) {
+            release(entry);
+        }
+    }
+
+    Buffer& find(uint64_t id, const std::shared_ptr<Registry>& registry)
+    {
+        for (auto&& entry : _entries) {
+            if (entry._id == id) {
+                return *entry._buffer;
+            }
+        }
+
+        _entries.erase(std::remove_if(_entries.begin(),
+                                      _entries.end(),
+                                      [](const Entry& entry) {
+                                          return entry._registry.expired();
+                                      }),
+                       _entries.end());
+
+        Entry entry;
+        entry._id = id;
+        entry._registry = registry;
+        entry._buffer = std::make_shared<Buffer>();
+        {
+            std::lock_guard<std::mutex> lock(registry->_mutex);
+            registry->_buffers.push_back(entry._buffer);
+        }
+        _entries.push_back(entry);
+        return *_entries.back()._buffer;
+    }
+
+  private:
+    struct Entry {
+        uint64_t _id;
+        std::weak_ptr<Registry> _registry;
+        std::shared_ptr<Buffer> _buffer;
+    };
+
+    static void release(Entry& entry)
+    {
+        const auto registry = entry._registry.lock();
+        if (!registry) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(registry->_mutex);
+        {
+            std::lock_guard<std::mutex> bufferLock(entry._buffer->_mutex);
+            if (registry->_handOff && !entry._buffer->_spans.empty()) {
+                registry->_handOff(entry._buffer->_spans);
+            }
+            entry._buffer->_spans.clear();
+        }
+        auto& buffers = registry->_buffers;
+        buffers.erase(
+            std::remove(buffers.begin(), buffers.end(), entry._buffer),
+            buffers.end());
+    }
+
+    std::vector<Entry> _entries;
+};
+
+StagingBuffers::StagingBuffers(size_t batchSize,
+                               const Clock::duration& maxAge,
+                               HandOff handOff)
+    : _batchSize(batchSize > 0 ? batchSize : 1)
+    , _maxAge(maxAge.count() > 0 ? maxAge : defaultMaxAge())
+    , _handOff(std::move(handOff))
+    , _id(nextId++)
+    , _registry(std::make_shared<Registry>())
+{
+    _registry->_handOff = _handOff;
+}
+
+StagingBuffers::~StagingBuffers() { close(); }
+
+void StagingBuffers::add(std::unique_ptr<Span>&& span)
+{
+    auto& buffer = threadBuffer();
+    // Only contended while handOffStale() or close() visit this buffer.
+    std::lock_guard<std::mutex> lock(buffer._mutex);
+    const auto now = Clock::now();
+    if (buffer._spans.empty()) {
+        buffer._spans.reserve(_batchSize);
+        buffer._oldest = now;
+    }
+    buffer._spans.push_back(std::move(span));
+    if (buffer._spans.size() >= _batchSize ||
+        now - buffer._oldest >= _maxAge) {
+        _handOff(buffer._spans);
+        buffer._spans.clear();
+    }
+}
+
+void StagingBuffers::handOffStale()
+{
+    std::lock_guard<std::mutex> lock(_registry->_mutex);
+    if (!_registry->_handOff) {
+        return;
+    }
+    const auto now = Clock::now();
+    for (auto&& buffer : _registry->_buffers) {
+        // Skip buffers their thread is busy with, it will hand them off
+        // itself.
+        std::unique_lock<std::mutex> bufferLock(buffer->_mutex,
+                                                std::try_to_lock);
+        if (bufferLock && !buffer->_spans.empty() &&
+            now - buffer->_oldest >= _maxAge) {
+            _handOff(buffer->_spans);
+            buffer->_spans.clear();
+        }
+    }
+}
+
+void StagingBuffers::close()
+{
+    std::lock_guard<std::mutex> lock(_registry->_mutex);
+    if (!_registry->_handOff) {
+        return;
+    }
+    for (auto&& buffer : _registry->_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->_mutex);
+        if (!buffer->_spans.empty()) {
+            _handOff(buffer->_spans);
+            buffer->_spans.clear();
+        }
+    }
+    _registry->_handOff = HandOff();
+}
+
+StagingBuffers::Buffer& StagingBuffers::threadBuffer()
+{
+    static thread_local ThreadBuffers threadBuffers;
+    return threadBuffers.find(_id, _registry);
+}
+
+}  // namespace reporters
+}  // namespace jaegertracing
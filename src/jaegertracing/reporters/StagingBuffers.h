@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_REPORTERS_STAGINGBUFFERS_H
+#define JAEGERTRACING_REPORTERS_STAGINGBUFFERS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jaegertracing {
+
+class Span;
+
+namespace reporters {
+
+// Collects finished spans in a small buffer per application thread and hands
+// them to the owner in batches, once a buffer holds `batchSize` spans or its
+// oldest span is older than `maxAge`. Buffers are handed off when their
+// thread exits and on close(); handOffStale() lets a background thread pick
+// up spans from threads that went quiet.
+class StagingBuffers {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using SpanBatch = std::vector<std::unique_ptr<Span>>;
+    // Takes the spans it wants out of the batch; whatever is left is dropped.
+    using HandOff = std::function<void(SpanBatch&)>;
+
+    static Clock::duration defaultMaxAge()
+    {
+        return std::chrono::milliseconds(100);
+    }
+
+    StagingBuffers(size_t batchSize,
+                   const Clock::duration& maxAge,
+                   HandOff handOff);
+
+    ~StagingBuffers();
+
+    StagingBuffers(const StagingBuffers&) = delete;
+
+    StagingBuffers& operator=(const StagingBuffers&) = delete;
+
+    void add(std::unique_ptr<Span>&& span);
+
+    void handOffStale();
+
+    void close();
+
+    const Clock::duration& maxAge() const { return _maxAge; }
+
+  private:
+    struct Buffer {
+        std::mutex _mutex;
+        SpanBatch _spans;
+        Clock::time_point _oldest;
+    };
+
+    // Shared with the thread-local handles so that a thread exiting after
+    // the owner is gone does not touch it.
+    struct Registry {
+        std::mutex _mutex;
+        HandOff _handOff;
+        std::vector<std::shared_ptr<Buffer>> _buffers;
+    };
+
+    class ThreadBuffers;
+
+    Buffer& threadBuffer();
+
+    size_t _batchSize;
+    Clock::duration _maxAge;
+    HandOff _handOff;
+    uint64_t _id;
+    std::shared_ptr<Registry> _registry;
+};
+
+}  // namespace reporters
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_REPORTERS_STAGINGBUFFERS_H
@@ -16,9 +16,18 @@
 
 #include "jaegertracing/testutils/MockAgent.h"
 
+#include <atomic>
+#include <cstring>
 #include <regex>
 #include <thread>
 
+#ifndef WIN32
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 #include <thrift/protocol/TCompactProtocol.h>
 #include <thrift/transport/TBufferTransports.h>
 
@@ -60,6 +69,17 @@ bool startsWith(const std::string& str, const std::string& prefix)
     return std::equal(std::begin(prefix), std::end(prefix), std::begin(str));
 }
 
+#ifndef WIN32
+std::string makeUnixPath()
+{
+    static std::atomic<int> counter(0);
+    std::ostringstream oss;
+    oss << "/tmp/jaeger-mock-agent-" << ::getpid() << '-' << counter++
+        << ".sock";
+    return oss.str();
+}
+#endif
+
 }  // anonymous namespace
 
 MockAgent::~MockAgent() { close(); }
@@ -73,6 +93,12 @@ void MockAgent::start()
         std::thread([this, &startedHTTP]() { serveHTTP(startedHTTP); });
     startedUDP.get_future().wait();
     startedHTTP.get_future().wait();
+#ifndef WIN32
+    std::promise<void> startedUnix;
+    _unixThread =
+        std::thread([this, &startedUnix]() { serveUnix(startedUnix); });
+    startedUnix.get_future().wait();
+#endif
 }
 
 void MockAgent::close()
@@ -87,6 +113,11 @@ void MockAgent::close()
         _servingHTTP = false;
         _httpThread.join();
     }
+
+    if (_servingUnix) {
+        _servingUnix = false;
+        _unixThread.join();
+    }
 }
 
 void MockAgent::emitBatch(const thrift::Batch& batch)
@@ -98,6 +129,8 @@ void MockAgent::emitBatch(const thrift::Batch& batch)
 MockAgent::MockAgent()
     : _transport(net::IPAddress::v4("127.0.0.1", 0))
     , _servingUDP(false)
+    , _servingHTTP(false)
+    , _servingUnix(false)
 {
 }
 
@@ -135,6 +168,67 @@ void MockAgent::serveUDP(std::promise<void>& started)
     }
 }
 
+#ifndef WIN32
+void MockAgent::serveUnix(std::promise<void>& started)
+{
+    using TCompactProtocolFactory =
+        apache::thrift::protocol::TCompactProtocolFactory;
+    using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+
+    _unixPath = makeUnixPath();
+    ::unlink(_unixPath.c_str());
+    net::Socket socket;
+    socket.open(AF_UNIX, SOCK_DGRAM);
+    ::sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, _unixPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (::bind(socket.handle(),
+               reinterpret_cast<const ::sockaddr*>(&addr),
+               sizeof(addr)) != 0) {
+        throw std::system_error(
+            errno, std::generic_category(), "Failed to bind Unix socket");
+    }
+    // Wake up regularly to notice close().
+    ::timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100 * 1000;
+    ::setsockopt(socket.handle(),
+                 SOL_SOCKET,
+                 SO_RCVTIMEO,
+                 &timeout,
+                 sizeof(timeout));
+
+    auto iface = shared_from_this();
+    agent::thrift::AgentProcessor handler(iface);
+    TCompactProtocolFactory protocolFactory;
+    std::shared_ptr<TMemoryBuffer> trans(
+        new TMemoryBuffer(utils::UnixTransporter::kUnixPacketMaxLength));
+
+    _servingUnix = true;
+    started.set_value();
+
+    std::vector<char> buffer(utils::UnixTransporter::kUnixPacketMaxLength);
+    while (isServingUnix()) {
+        try {
+            const auto numRead =
+                read(socket.handle(), &buffer[0], buffer.size());
+            if (numRead > 0) {
+                trans->write(reinterpret_cast<const uint8_t*>(&buffer[0]),
+                             numRead);
+                auto protocol = protocolFactory.getProtocol(trans);
+                handler.process(protocol, protocol, nullptr);
+            }
+        } catch (...) {
+            auto logger = logging::consoleLogger();
+            utils::ErrorUtil::logError(
+                *logger, "An error occurred in MockAgent::serveUnix");
+        }
+    }
+    ::unlink(_unixPath.c_str());
+}
+#endif
+
 void MockAgent::serveHTTP(std::promise<void>& started)
 {
     net::Socket socket;
@@ -26,6 +26,7 @@
 #include "jaegertracing/thrift-gen/Agent.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
 #include "jaegertracing/utils/UDPTransporter.h"
+#include "jaegertracing/utils/UnixTransporter.h"
 #include <atomic>
 #include <future>
 #include <memory>
@@ -84,6 +85,8 @@ class MockAgent : public agent::thrift::AgentIf,
 
     bool isServingHTTP() const { return _servingHTTP; }
 
+    bool isServingUnix() const { return _servingUnix; }
+
     template <typename... Args>
     void addSamplingStrategy(Args&&... args)
     {
@@ -110,6 +113,17 @@ class MockAgent : public agent::thrift::AgentIf,
             new utils::UDPTransporter(spanServerAddress(), 0));
     }
 
+#ifndef WIN32
+    // Path of the AF_UNIX datagram socket spans are also accepted on.
+    const std::string& unixSpanServerPath() const { return _unixPath; }
+
+    std::unique_ptr<utils::Transport> unixSpanServerClient()
+    {
+        return std::unique_ptr<utils::Transport>(
+            new utils::UnixTransporter(unixSpanServerPath(), 0));
+    }
+#endif
+
     net::IPAddress samplingServerAddress() const { return _httpAddress; }
 
     void resetBatches()
@@ -125,16 +139,21 @@ class MockAgent : public agent::thrift::AgentIf,
 
     void serveHTTP(std::promise<void>& started);
 
+    void serveUnix(std::promise<void>& started);
+
     TUDPTransport _transport;
     std::vector<thrift::Batch> _batches;
     std::atomic<bool> _servingUDP;
     std::atomic<bool> _servingHTTP;
+    std::atomic<bool> _servingUnix;
     SamplingManager _samplingMgr;
     KeyRestrictionMap _restrictions;
     mutable std::mutex _mutex;
     std::thread _udpThread;
     std::thread _httpThread;
+    std::thread _unixThread;
     net::IPAddress _httpAddress;
+    std::string _unixPath;
 };
 
 }  // namespace testutils
@@ -124,5 +124,34 @@ TEST(MockAgent, testSamplingManager)
     }
 }
 
+#ifndef WIN32
+TEST(MockAgent, testUnixSpanServer)
+{
+    auto mockAgent = MockAgent::make();
+    mockAgent->start();
+    ASSERT_TRUE(mockAgent->isServingUnix());
+
+    // Bigger than any UDP packet.
+    thrift::Batch batch;
+    batch.spans.resize(1);
+    batch.spans[0].__set_operationName(
+        std::string(2 * utils::UDPTransporter::kUDPPacketMaxLength, 'x'));
+    auto client = mockAgent->unixSpanServerClient();
+    client->emitBatch(batch);
+
+    for (auto i = 0; i < 100 && mockAgent->batches().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto batches = mockAgent->batches();
+    ASSERT_EQ(1, static_cast<int>(batches.size()));
+    ASSERT_EQ(1, static_cast<int>(batches[0].spans.size()));
+    ASSERT_EQ(batch.spans[0].operationName,
+              batches[0].spans[0].operationName);
+
+    mockAgent->close();
+    ASSERT_FALSE(mockAgent->isServingUnix());
+}
+#endif
+
 }  // namespace testutils
 }  // namespace jaegertracing
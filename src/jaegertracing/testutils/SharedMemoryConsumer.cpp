@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/testutils/SharedMemoryConsumer.h"
+
+#ifndef WIN32
+
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#include "jaegertracing/Logging.h"
+#include "jaegertracing/utils/ErrorUtil.h"
+
+namespace jaegertracing {
+namespace testutils {
+
+SharedMemoryConsumer::SharedMemoryConsumer(
+    const std::shared_ptr<utils::SharedMemoryRing>& ring,
+    const std::shared_ptr<agent::thrift::AgentIf>& agent)
+    : _ring(ring)
+    , _agent(agent)
+    , _record()
+    , _polling(false)
+    , _thread()
+{
+}
+
+int SharedMemoryConsumer::poll()
+{
+    using TCompactProtocolFactory =
+        apache::thrift::protocol::TCompactProtocolFactory;
+    using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+
+    TCompactProtocolFactory protocolFactory;
+    auto numRecords = 0;
+    while (_ring->read(_record)) {
+        ++numRecords;
+        try {
+            std::shared_ptr<TMemoryBuffer> trans(new TMemoryBuffer(
+                reinterpret_cast<uint8_t*>(&_record[0]),
+                static_cast<uint32_t>(_record.size()),
+                TMemoryBuffer::OBSERVE));
+            auto protocol = protocolFactory.getProtocol(trans);
+            thrift::Batch batch;
+            batch.read(protocol.get());
+            _agent->emitBatch(batch);
+        } catch (...) {
+            auto logger = logging::consoleLogger();
+            utils::ErrorUtil::logError(
+                *logger, "An error occurred in SharedMemoryConsumer::poll");
+        }
+    }
+    return numRecords;
+}
+
+void SharedMemoryConsumer::start(const std::chrono::milliseconds& interval)
+{
+    _polling = true;
+    _thread = std::thread([this, interval]() {
+        while (_polling) {
+            if (poll() == 0) {
+                std::this_thread::sleep_for(interval);
+            }
+        }
+        poll();
+    });
+}
+
+void SharedMemoryConsumer::close()
+{
+    if (_polling) {
+        _polling = false;
+        _thread.join();
+    }
+}
+
+}  // namespace testutils
+}  // namespace jaegertracing
+
+#endif  // WIN32
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_TESTUTILS_SHAREDMEMORYCONSUMER_H
+#define JAEGERTRACING_TESTUTILS_SHAREDMEMORYCONSUMER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "jaegertracing/thrift-gen/Agent.h"
+#include "jaegertracing/utils/SharedMemoryRing.h"
+
+#ifndef WIN32
+
+namespace jaegertracing {
+namespace testutils {
+
+// Reference consumer of the ring SharedMemoryTransporter writes to. Decodes
+// each record into a batch and hands it to `agent`, the way MockAgent
+// handles the batches it receives over UDP.
+class SharedMemoryConsumer {
+  public:
+    SharedMemoryConsumer(const std::shared_ptr<utils::SharedMemoryRing>& ring,
+                         const std::shared_ptr<agent::thrift::AgentIf>& agent);
+
+    ~SharedMemoryConsumer() { close(); }
+
+    SharedMemoryConsumer(const SharedMemoryConsumer&) = delete;
+
+    SharedMemoryConsumer& operator=(const SharedMemoryConsumer&) = delete;
+
+    // Consumes the records written so far and returns how many there were.
+    int poll();
+
+    // Polls on a background thread every `interval` until close().
+    void start(const std::chrono::milliseconds& interval =
+                   std::chrono::milliseconds(1));
+
+    void close();
+
+  private:
+    std::shared_ptr<utils::SharedMemoryRing> _ring;
+    std::shared_ptr<agent::thrift::AgentIf> _agent;
+    std::string _record;
+    std::atomic<bool> _polling;
+    std::thread _thread;
+};
+
+}  // namespace testutils
+}  // namespace jaegertracing
+
+#endif  // WIN32
+
+#endif  // JAEGERTRACING_TESTUTILS_SHAREDMEMORYCONSUMER_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/Arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace jaegertracing {
+namespace utils {
+
+constexpr size_t Arena::kInitialChunkSize;
+constexpr size_t Arena::kMaxChunkSize;
+
+Arena::~Arena() { free(_head); }
+
+void Arena::swap(Arena& other) noexcept
+{
+    using std::swap;
+    swap(_head, other._head);
+    swap(_used, other._used);
+    swap(_capacity, other._capacity);
+}
+
+opentracing::string_view Arena::copy(opentracing::string_view value)
+{
+    if (value.size() == 0) {
+        return opentracing::string_view("", 0);
+    }
+    if (!_head || _head->_size - _used < value.size()) {
+        const auto size = std::max(
+            value.size(),
+            _head ? std::min(2 * _head->_size, kMaxChunkSize)
+                  : kInitialChunkSize);
+        auto* chunk =
+            static_cast<Chunk*>(::operator new(sizeof(Chunk) + size));
+        chunk->_next = _head;
+        chunk->_size = size;
+        _head = chunk;
+        _used = 0;
+        _capacity += size;
+    }
+    auto* copy = data(_head) + _used;
+    std::memcpy(copy, value.data(), value.size());
+    _used += value.size();
+    return opentracing::string_view(copy, value.size());
+}
+
+void Arena::reset()
+{
+    if (!_head) {
+        return;
+    }
+    // Usually the newest, but a string longer than the next chunk size gets
+    // a chunk of its own.
+    auto** largest = &_head;
+    for (auto** link = &_head->_next; *link; link = &(*link)->_next) {
+        if ((*link)->_size > (*largest)->_size) {
+            largest = link;
+        }
+    }
+    auto* kept = *largest;
+    *largest = kept->_next;
+    kept->_next = nullptr;
+    free(_head);
+    _head = kept;
+    _used = 0;
+    _capacity = kept->_size;
+}
+
+void Arena::free(Chunk* chunk)
+{
+    while (chunk) {
+        auto* next = chunk->_next;
+        ::operator delete(chunk);
+        chunk = next;
+    }
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
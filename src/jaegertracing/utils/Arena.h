@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_ARENA_H
+#define JAEGERTRACING_UTILS_ARENA_H
+
+#include <cstddef>
+#include <utility>
+
+#include <opentracing/string_view.h>
+
+namespace jaegertracing {
+namespace utils {
+
+// Bump allocator for the strings of one span. Strings are copied one after
+// the other into heap chunks, each twice the size of the previous one up to
+// kMaxChunkSize, or as large as a longer string, and only freed together.
+// Moving an arena keeps the views it handed out valid, since the chunks stay
+// where they are.
+class Arena {
+  public:
+    static constexpr size_t kInitialChunkSize = 256;
+    static constexpr size_t kMaxChunkSize = 16384;
+
+    Arena() noexcept
+        : _head(nullptr)
+        , _used(0)
+        , _capacity(0)
+    {
+    }
+
+    Arena(Arena&& other) noexcept
+        : Arena()
+    {
+        swap(other);
+    }
+
+    Arena& operator=(Arena&& other) noexcept
+    {
+        Arena tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena();
+
+    void swap(Arena& other) noexcept;
+
+    // Returns a view of the copy, valid until the arena is reset or
+    // destroyed.
+    opentracing::string_view copy(opentracing::string_view value);
+
+    // Bytes held in chunks.
+    size_t capacity() const { return _capacity; }
+
+    // Frees every chunk but the largest, and empties it for reuse. Views
+    // handed out before are no longer valid.
+    void reset();
+
+  private:
+    struct Chunk {
+        Chunk* _next;
+        size_t _size;
+    };
+
+    static char* data(Chunk* chunk)
+    {
+        return reinterpret_cast<char*>(chunk + 1);
+    }
+
+    static void free(Chunk* chunk);
+
+    Chunk* _head;
+    size_t _used;
+    size_t _capacity;
+};
+
+inline void swap(Arena& lhs, Arena& rhs) noexcept { lhs.swap(rhs); }
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_ARENA_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/Arena.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(Arena, testCopy)
+{
+    Arena arena;
+    ASSERT_EQ(0, arena.capacity());
+    ASSERT_EQ(0, arena.copy("").size());
+    ASSERT_EQ(0, arena.capacity());
+
+    std::string value("value");
+    const auto view = arena.copy(value);
+    value = "other";
+    ASSERT_EQ("value", std::string(view.data(), view.size()));
+    ASSERT_EQ(Arena::kInitialChunkSize, arena.capacity());
+
+    // Views stay valid as the arena grows and when it is moved.
+    std::vector<opentracing::string_view> views;
+    for (auto i = 0; i < 100; ++i) {
+        views.push_back(arena.copy(std::to_string(i) + "-0123456789"));
+    }
+    ASSERT_GT(arena.capacity(), Arena::kInitialChunkSize);
+    Arena moved(std::move(arena));
+    ASSERT_EQ(0, arena.capacity());
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_EQ(std::to_string(i) + "-0123456789",
+                  std::string(views[i].data(), views[i].size()));
+    }
+
+    const std::string large(2 * Arena::kMaxChunkSize, 'x');
+    const auto largeView = moved.copy(large);
+    ASSERT_EQ(large, std::string(largeView.data(), largeView.size()));
+}
+
+TEST(Arena, testReset)
+{
+    Arena arena;
+    for (auto i = 0; i < 100; ++i) {
+        arena.copy("0123456789");
+    }
+    const auto capacity = arena.capacity();
+    ASSERT_GT(capacity, Arena::kInitialChunkSize);
+    arena.reset();
+    ASSERT_LT(arena.capacity(), capacity);
+    ASSERT_GT(arena.capacity(), 0);
+
+    // The kept chunk is reused before another one is allocated.
+    const auto kept = arena.capacity();
+    arena.copy("0123456789");
+    ASSERT_EQ(kept, arena.capacity());
+}
+
+TEST(Arena, testResetKeepsLargestChunk)
+{
+    // A long string gets a chunk of its own, then the next chunk goes back
+    // to the regular size.
+    Arena arena;
+    const std::string large(2 * Arena::kMaxChunkSize, 'x');
+    arena.copy(large);
+    arena.copy(std::string(Arena::kInitialChunkSize, 'y'));
+    ASSERT_GT(arena.capacity(), large.size());
+
+    arena.reset();
+    ASSERT_EQ(large.size(), arena.capacity());
+    const auto view = arena.copy(large);
+    ASSERT_EQ(large, std::string(view.data(), view.size()));
+    ASSERT_EQ(large.size(), arena.capacity());
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -0,0 +1,590 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/AsyncHTTPTransporter.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <system_error>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "jaegertracing/net/http/Request.h"
+#include "jaegertracing/net/http/Response.h"
+#include "jaegertracing/utils/ErrorUtil.h"
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+constexpr auto kMaxEvents = 16;
+constexpr auto kReadBufferSize = 4096;
+constexpr auto kContentType = "application/x-thrift";
+
+std::chrono::seconds closeTimeout() { return std::chrono::seconds(5); }
+
+constexpr auto kTimedOut = "Timed out waiting for collector";
+
+std::string errorMessage(int error, const std::string& what)
+{
+    return std::system_error(error, std::system_category(), what).what();
+}
+
+}  // anonymous namespace
+
+constexpr int AsyncHTTPTransporter::kDefaultMaxInFlight;
+
+AsyncHTTPTransporter::AsyncHTTPTransporter(
+    const net::URI& endpoint,
+    int maxPacketSize,
+    int maxInFlight,
+    logging::Logger& logger,
+    metrics::Metrics& metrics,
+    std::unique_ptr<Compressor>&& compressor,
+    const Clock::duration& requestTimeout)
+    : Transport(maxPacketSize == 0 ? kHttpPacketMaxLength : maxPacketSize)
+    , _buffer(new apache::thrift::transport::TMemoryBuffer(_maxPacketSize))
+    , _serverAddr(net::IPAddress::v4(endpoint._host, endpoint._port))
+    , _protocol()
+    , _host(endpoint.authority())
+    , _target(endpoint._path + "?format=jaeger.thrift")
+    , _compressor(std::move(compressor))
+    , _maxInFlight(maxInFlight > 0 ? maxInFlight : kDefaultMaxInFlight)
+    , _requestTimeout(requestTimeout.count() > 0 ? requestTimeout
+                                                 : defaultRequestTimeout())
+    , _logger(logger)
+    , _metrics(metrics)
+    , _epoll(-1)
+    , _wakeup(-1)
+    , _mutex()
+    , _completed()
+    , _queue()
+    , _numOutstanding(0)
+    , _closing(false)
+    , _connections()
+    , _thread()
+{
+    _protocol = protocolFactory()->getProtocol(_buffer);
+
+    _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0) {
+        throw std::system_error(
+            errno, std::system_category(), "Failed to create epoll instance");
+    }
+    _wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeup < 0) {
+        const auto error = errno;
+        ::close(_epoll);
+        throw std::system_error(
+            error, std::system_category(), "Failed to create eventfd");
+    }
+    ::epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event);
+
+    _thread = std::thread([this]() { run(); });
+}
+
+void AsyncHTTPTransporter::emitBatch(const thrift::Batch& batch)
+{
+    _buffer->resetBuffer();
+    auto oprot = _protocol.get();
+    batch.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    submit(static_cast<int>(batch.spans.size()));
+}
+
+void AsyncHTTPTransporter::emitSerializedBatch(const std::string& process,
+                                               const std::string& spans,
+                                               int numSpans)
+{
+    _buffer->resetBuffer();
+    auto oprot = _protocol.get();
+    writeSerializedBatch(*oprot, process, spans, numSpans);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    submit(numSpans);
+}
+
+void AsyncHTTPTransporter::close()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_closing) {
+            _completed.wait_for(lock, closeTimeout(), [this]() {
+                return _numOutstanding == 0;
+            });
+            _closing = true;
+            _completed.notify_all();
+        }
+    }
+    // The I/O thread may have closed the transporter itself when it failed.
+    if (!_thread.joinable()) {
+        return;
+    }
+    wake();
+    _thread.join();
+    ::close(_wakeup);
+    ::close(_epoll);
+}
+
+void AsyncHTTPTransporter::submit(int numSpans)
+{
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    _buffer->getBuffer(&data, &size);
+
+    // The compressed body is handed over as it is; an uncompressed one is
+    // copied out of _buffer, which the next batch reuses.
+    std::unique_ptr<Request> request(new Request());
+    const char* contentEncoding = "";
+    if (_compressor) {
+        _compressor->compress(data, size, _compressed);
+        request->_body.swap(_compressed);
+        contentEncoding = _compressor->contentEncoding();
+    }
+    else {
+        request->_body.assign(reinterpret_cast<const char*>(data), size);
+    }
+    request->_head = net::http::formatPostHead(
+        _host, _target, kContentType, request->_body.size(), contentEncoding);
+    request->_numSpans = numSpans;
+    request->_retried = false;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        // Requests in flight time out well before then, so this only fails
+        // if the I/O thread is stuck.
+        if (!_completed.wait_for(lock, 2 * _requestTimeout, [this]() {
+                return _closing || _numOutstanding < _maxInFlight;
+            })) {
+            throw std::runtime_error(kTimedOut);
+        }
+        if (_closing) {
+            throw std::logic_error("Transporter is closed");
+        }
+        request->_deadline = Clock::now() + _requestTimeout;
+        _queue.push_back(std::move(request));
+        ++_numOutstanding;
+    }
+    wake();
+}
+
+void AsyncHTTPTransporter::wake()
+{
+    const uint64_t value = 1;
+    // Fails only if the counter would overflow, in which case the I/O
+    // thread is already due to wake up.
+    const auto result = ::write(_wakeup, &value, sizeof(value));
+    (void)result;
+}
+
+void AsyncHTTPTransporter::run() noexcept
+{
+    std::array<::epoll_event, kMaxEvents> events;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closing) {
+                break;
+            }
+        }
+        startRequests();
+
+        const auto numEvents =
+            ::epoll_wait(_epoll, &events[0], events.size(), waitTimeout());
+        if (numEvents < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _logger.error(errorMessage(errno, "epoll_wait failed"));
+            // Fail submit() from now on rather than let it wait for room
+            // that this thread will no longer make.
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closing = true;
+            _completed.notify_all();
+            break;
+        }
+        for (auto i = 0; i < numEvents; ++i) {
+            if (events[i].data.ptr == nullptr) {
+                uint64_t value = 0;
+                const auto result = ::read(_wakeup, &value, sizeof(value));
+                (void)result;
+                continue;
+            }
+            auto& connection = *static_cast<Connection*>(events[i].data.ptr);
+            if (!connection._closed) {
+                handle(connection);
+            }
+        }
+        expireRequests();
+
+        // Closing the sockets also takes them out of the epoll set.
+        _connections.erase(
+            std::remove_if(_connections.begin(),
+                           _connections.end(),
+                           [](const std::unique_ptr<Connection>& connection) {
+                               return connection->_closed;
+                           }),
+            _connections.end());
+    }
+
+    // Whatever is left will not be sent.
+    for (auto&& connection : _connections) {
+        if (connection->_request) {
+            complete(*connection->_request, "Transporter closed");
+        }
+    }
+    _connections.clear();
+    std::deque<std::unique_ptr<Request>> queue;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        queue.swap(_queue);
+    }
+    for (auto&& request : queue) {
+        complete(*request, "Transporter closed");
+    }
+}
+
+void AsyncHTTPTransporter::startRequests()
+{
+    while (true) {
+        Connection* idle = nullptr;
+        auto numOpen = 0;
+        for (auto&& connection : _connections) {
+            if (!connection->_closed) {
+                ++numOpen;
+                if (connection->_state == State::kIdle) {
+                    idle = connection.get();
+                }
+            }
+        }
+        if (idle == nullptr && numOpen >= _maxInFlight) {
+            return;
+        }
+
+        std::unique_ptr<Request> request;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_queue.empty()) {
+                return;
+            }
+            request = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        if (idle != nullptr) {
+            idle->_request = std::move(request);
+            idle->_state = State::kWriting;
+            idle->_numWritten = 0;
+            watch(*idle, EPOLLOUT, EPOLL_CTL_MOD);
+        }
+        else {
+            openConnection(std::move(request));
+        }
+    }
+}
+
+void AsyncHTTPTransporter::openConnection(std::unique_ptr<Request>&& request)
+{
+    std::unique_ptr<Connection> connection(new Connection());
+    connection->_state = State::kConnecting;
+    connection->_reused = false;
+    connection->_closed = false;
+    connection->_request = std::move(request);
+    connection->_numWritten = 0;
+    try {
+        connection->_socket.open(AF_INET,
+                                 SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC);
+    } catch (const std::exception& ex) {
+        complete(*connection->_request, ex.what());
+        return;
+    }
+
+    const auto result = ::connect(
+        connection->_socket.handle(),
+        reinterpret_cast<const ::sockaddr*>(&_serverAddr.addr()),
+        _serverAddr.addrLen());
+    if (result != 0 && errno != EINPROGRESS) {
+        complete(*connection->_request,
+                 errorMessage(errno, "Failed to connect to collector"));
+        return;
+    }
+    watch(*connection, EPOLLOUT, EPOLL_CTL_ADD);
+    _connections.push_back(std::move(connection));
+}
+
+void AsyncHTTPTransporter::watch(Connection& connection,
+                                 uint32_t events,
+                                 int operation)
+{
+    ::epoll_event event = {};
+    event.events = events;
+    event.data.ptr = &connection;
+    if (::epoll_ctl(_epoll, operation, connection._socket.handle(), &event) !=
+        0) {
+        fail(connection, errorMessage(errno, "epoll_ctl failed"));
+    }
+}
+
+void AsyncHTTPTransporter::handle(Connection& connection)
+{
+    switch (connection._state) {
+    case State::kConnecting: {
+        auto error = 0;
+        ::socklen_t errorLen = sizeof(error);
+        ::getsockopt(connection._socket.handle(),
+                     SOL_SOCKET,
+                     SO_ERROR,
+                     &error,
+                     &errorLen);
+        if (error != 0) {
+            fail(connection,
+                 errorMessage(error, "Failed to connect to collector"));
+            return;
+        }
+        connection._state = State::kWriting;
+        write(connection);
+    } break;
+    case State::kWriting: {
+        write(connection);
+    } break;
+    case State::kReading: {
+        read(connection);
+    } break;
+    default: {
+        assert(connection._state == State::kIdle);
+        // The collector closed the idle connection, or sent something it
+        // should not have.
+        connection._closed = true;
+    } break;
+    }
+}
+
+void AsyncHTTPTransporter::write(Connection& connection)
+{
+    const auto& head = connection._request->_head;
+    const auto& body = connection._request->_body;
+    while (connection._numWritten < head.size() + body.size()) {
+        std::array<::iovec, 2> parts;
+        auto numParts = 0;
+        if (connection._numWritten < head.size()) {
+            parts[numParts].iov_base =
+                const_cast<char*>(head.data()) + connection._numWritten;
+            parts[numParts].iov_len = head.size() - connection._numWritten;
+            ++numParts;
+        }
+        const auto bodyOffset = connection._numWritten < head.size()
+                                    ? 0
+                                    : connection._numWritten - head.size();
+        parts[numParts].iov_base = const_cast<char*>(body.data()) + bodyOffset;
+        parts[numParts].iov_len = body.size() - bodyOffset;
+        ++numParts;
+        ::msghdr message = {};
+        message.msg_iov = &parts[0];
+        message.msg_iovlen = numParts;
+        const auto result =
+            ::sendmsg(connection._socket.handle(), &message, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (errno != EINTR) {
+                fail(connection,
+                     errorMessage(errno, "Failed to write message"));
+                return;
+            }
+        }
+        else {
+            connection._numWritten += result;
+        }
+    }
+    connection._state = State::kReading;
+    watch(connection, EPOLLIN, EPOLL_CTL_MOD);
+}
+
+void AsyncHTTPTransporter::read(Connection& connection)
+{
+    std::array<char, kReadBufferSize> buffer;
+    auto atEnd = false;
+    while (!atEnd) {
+        const auto result =
+            ::recv(connection._socket.handle(), &buffer[0], buffer.size(), 0);
+        if (result > 0) {
+            connection._received.append(&buffer[0], result);
+        }
+        else if (result == 0) {
+            atEnd = true;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        else if (errno != EINTR) {
+            fail(connection, errorMessage(errno, "Failed to read response"));
+            return;
+        }
+    }
+
+    net::http::Response response;
+    auto reusable = false;
+    try {
+        if (!net::http::parseResponse(
+                connection._received, atEnd, response, reusable)) {
+            if (atEnd) {
+                fail(connection,
+                     "Connection closed before end of HTTP response");
+            }
+            return;
+        }
+    } catch (const std::exception& ex) {
+        fail(connection, ex.what());
+        return;
+    }
+
+    auto request = std::move(connection._request);
+    if (reusable && !atEnd) {
+        connection._state = State::kIdle;
+        connection._reused = true;
+        watch(connection, EPOLLIN, EPOLL_CTL_MOD);
+    }
+    else {
+        connection._closed = true;
+    }
+
+    if (response.statusCode() < 200 || response.statusCode() > 299) {
+        std::ostringstream oss;
+        oss << "HTTP error " << response.statusCode() << ' '
+            << response.reason();
+        complete(*request, oss.str());
+    }
+    else {
+        complete(*request, std::string());
+    }
+}
+
+void AsyncHTTPTransporter::fail(Connection& connection,
+                                const std::string& error)
+{
+    connection._closed = true;
+    auto request = std::move(connection._request);
+    if (!request) {
+        return;
+    }
+    if (connection._reused && connection._received.empty() &&
+        !request->_retried) {
+        // The collector may have closed the idle connection in the
+        // meantime, try once more on a new one.
+        request->_retried = true;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_front(std::move(request));
+        return;
+    }
+    complete(*request, error);
+}
+
+int AsyncHTTPTransporter::waitTimeout()
+{
+    auto deadline = Clock::time_point::max();
+    for (auto&& connection : _connections) {
+        if (!connection->_closed && connection->_request) {
+            deadline = std::min(deadline, connection->_request->_deadline);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto&& request : _queue) {
+            deadline = std::min(deadline, request->_deadline);
+        }
+    }
+    if (deadline == Clock::time_point::max()) {
+        return -1;
+    }
+    const auto now = Clock::now();
+    if (deadline <= now) {
+        return 0;
+    }
+    // Rounded up, so that the deadline has passed on waking up.
+    const auto timeout =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+            .count() +
+        1;
+    return static_cast<int>(std::min<int64_t>(
+        timeout, std::numeric_limits<int>::max()));
+}
+
+void AsyncHTTPTransporter::expireRequests()
+{
+    const auto now = Clock::now();
+    for (auto&& connection : _connections) {
+        if (!connection->_closed && connection->_request &&
+            connection->_request->_deadline <= now) {
+            // The response may still come, so the connection cannot be
+            // reused.
+            connection->_closed = true;
+            auto request = std::move(connection->_request);
+            complete(*request, kTimedOut);
+        }
+    }
+
+    std::vector<std::unique_ptr<Request>> expired;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto request = _queue.begin(); request != _queue.end();) {
+            if ((*request)->_deadline <= now) {
+                expired.push_back(std::move(*request));
+                request = _queue.erase(request);
+            }
+            else {
+                ++request;
+            }
+        }
+    }
+    for (auto&& request : expired) {
+        complete(*request, kTimedOut);
+    }
+}
+
+void AsyncHTTPTransporter::complete(const Request& request,
+                                    const std::string& error)
+{
+    if (error.empty()) {
+        _metrics.reporterSuccess().inc(request._numSpans);
+    }
+    else {
+        _metrics.reporterFailure().inc(request._numSpans);
+        _logger.error("Failed to send spans to collector: " + error);
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_numOutstanding;
+    _completed.notify_all();
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // __linux__
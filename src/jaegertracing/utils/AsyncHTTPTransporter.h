@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_ASYNCHTTPTRANSPORTER_H
+#define JAEGERTRACING_UTILS_ASYNCHTTPTRANSPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "jaegertracing/Logging.h"
+#include "jaegertracing/metrics/Metrics.h"
+#include "jaegertracing/net/IPAddress.h"
+#include "jaegertracing/net/Socket.h"
+#include "jaegertracing/net/URI.h"
+#include "jaegertracing/utils/Compressor.h"
+#include "jaegertracing/utils/Transport.h"
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+namespace jaegertracing {
+namespace utils {
+
+#ifdef __linux__
+
+// Posts batches to the collector like HTTPTransporter, but without waiting
+// for the response: an I/O thread drives up to `maxInFlight` requests at
+// once over non-blocking keep-alive connections with epoll. Emitting only
+// blocks while that many batches are outstanding. Completed batches are
+// counted in reporterSuccess() or reporterFailure() of `metrics`. Request
+// bodies are compressed with `compressor` when it is set. A batch not
+// acknowledged within `requestTimeout` of being emitted fails, and emitting
+// throws if it finds no room for the batch within twice that time.
+class AsyncHTTPTransporter : public Transport {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto kDefaultMaxInFlight = 4;
+
+    static Clock::duration defaultRequestTimeout()
+    {
+        return std::chrono::seconds(10);
+    }
+
+    AsyncHTTPTransporter(
+        const net::URI& endpoint,
+        int maxPacketSize,
+        int maxInFlight,
+        logging::Logger& logger,
+        metrics::Metrics& metrics,
+        std::unique_ptr<Compressor>&& compressor = nullptr,
+        const Clock::duration& requestTimeout = defaultRequestTimeout());
+
+    ~AsyncHTTPTransporter() { close(); }
+
+    void emitBatch(const thrift::Batch& batch) override;
+
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override;
+
+    bool asynchronous() const override { return true; }
+
+    // Waits a bounded time for outstanding batches, then stops the I/O
+    // thread. Batches still outstanding count as failed.
+    void close() override;
+
+    std::unique_ptr<apache::thrift::protocol::TProtocolFactory>
+    protocolFactory() const override
+    {
+        return std::unique_ptr<apache::thrift::protocol::TProtocolFactory>(
+            new apache::thrift::protocol::TBinaryProtocolFactory());
+    }
+
+  private:
+    // The head and body are written together with sendmsg(), so that the
+    // body does not have to be copied behind the head.
+    struct Request {
+        std::string _head;
+        std::string _body;
+        Clock::time_point _deadline;
+        int _numSpans;
+        // Already sent once on a connection the collector had closed.
+        bool _retried;
+    };
+
+    enum class State { kConnecting, kWriting, kReading, kIdle };
+
+    struct Connection {
+        net::Socket _socket;
+        State _state;
+        // Whether the connection already carried a request.
+        bool _reused;
+        bool _closed;
+        std::unique_ptr<Request> _request;
+        size_t _numWritten;
+        std::string _received;
+    };
+
+    // Queues a POST of the batch in _buffer.
+    void submit(int numSpans);
+
+    void wake();
+
+    void run() noexcept;
+
+    // Hands queued requests to idle or new connections.
+    void startRequests();
+
+    void openConnection(std::unique_ptr<Request>&& request);
+
+    void watch(Connection& connection, uint32_t events, int operation);
+
+    void handle(Connection& connection);
+
+    void write(Connection& connection);
+
+    void read(Connection& connection);
+
+    void fail(Connection& connection, const std::string& error);
+
+    // Milliseconds until the earliest request deadline, for epoll_wait().
+    int waitTimeout();
+
+    // Fails requests past their deadline, closing their connections.
+    void expireRequests();
+
+    // Counts the spans of `request` as sent, or as failed if `error` is
+    // not empty.
+    void complete(const Request& request, const std::string& error);
+
+    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _buffer;
+    net::IPAddress _serverAddr;
+    std::shared_ptr<apache::thrift::protocol::TProtocol> _protocol;
+    std::string _host;
+    std::string _target;
+    std::unique_ptr<Compressor> _compressor;
+    std::string _compressed;
+    int _maxInFlight;
+    Clock::duration _requestTimeout;
+    logging::Logger& _logger;
+    metrics::Metrics& _metrics;
+    int _epoll;
+    int _wakeup;
+    std::mutex _mutex;
+    std::condition_variable _completed;
+    std::deque<std::unique_ptr<Request>> _queue;
+    // Requests queued or in flight.
+    int _numOutstanding;
+    bool _closing;
+    // Only used by the I/O thread.
+    std::vector<std::unique_ptr<Connection>> _connections;
+    std::thread _thread;
+
+    static constexpr auto kHttpPacketMaxLength = 1024 * 1024; // 1MB
+};
+
+#endif  // __linux__
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_ASYNCHTTPTRANSPORTER_H
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/AsyncHTTPTransporter.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
+#include "jaegertracing/net/http/Request.h"
+
+namespace jaegertracing {
+namespace utils {
+
+#ifdef __linux__
+
+namespace {
+
+int64_t reportedSpans(const metrics::InMemoryStatsReporter& stats,
+                      const std::string& state)
+{
+    const auto itr = stats.counters().find(
+        metrics::Metrics::addTagsToMetricName("jaeger.reporter-spans",
+                                              { { "state", state } }));
+    return (itr == std::end(stats.counters())) ? 0 : itr->second;
+}
+
+thrift::Batch makeBatch(int numSpans)
+{
+    thrift::Batch batch;
+    batch.process.__set_serviceName("test-service");
+    batch.spans.resize(numSpans);
+    return batch;
+}
+
+}  // anonymous namespace
+
+TEST(AsyncHTTPTransporter, testBatchesInFlight)
+{
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    socket.listen();
+
+    // Serves each connection on its own thread until the client closes it.
+    std::atomic<int> numRequests(0);
+    std::atomic<int> numConnections(0);
+    std::vector<std::thread> connectionThreads;
+    std::thread acceptThread(
+        [&socket, &numRequests, &numConnections, &connectionThreads]() {
+            while (true) {
+                std::unique_ptr<net::Socket> clientSocket;
+                try {
+                    clientSocket.reset(new net::Socket(socket.accept()));
+                } catch (const std::system_error&) {
+                    return;
+                }
+                ++numConnections;
+                auto* client = clientSocket.release();
+                connectionThreads.emplace_back([client, &numRequests]() {
+                    std::unique_ptr<net::Socket> owner(client);
+                    const std::string answer("HTTP/1.1 202 Accepted\r\n"
+                                             "Content-Length: 0\r\n\r\n");
+                    try {
+                        while (true) {
+                            net::http::Request::read(*client);
+                            ++numRequests;
+                            ::send(client->handle(),
+                                   answer.c_str(),
+                                   answer.size(),
+                                   0);
+                        }
+                    } catch (...) {
+                    }
+                });
+            }
+        });
+
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto logger = logging::nullLogger();
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    constexpr auto kNumBatches = 6;
+    constexpr auto kMaxInFlight = 2;
+    {
+        AsyncHTTPTransporter transporter(
+            net::URI::parse(oss.str()), 0, kMaxInFlight, *logger, *metrics);
+        ASSERT_TRUE(transporter.asynchronous());
+        for (auto i = 0; i < kNumBatches; ++i) {
+            ASSERT_NO_THROW(transporter.emitBatch(makeBatch(2)));
+        }
+        transporter.close();
+    }
+
+    ::shutdown(socket.handle(), SHUT_RDWR);
+    acceptThread.join();
+    for (auto&& thread : connectionThreads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(kNumBatches, numRequests);
+    ASSERT_GE(kMaxInFlight, numConnections);
+    ASSERT_EQ(2 * kNumBatches, reportedSpans(stats, "success"));
+    ASSERT_EQ(0, reportedSpans(stats, "failure"));
+}
+
+TEST(AsyncHTTPTransporter, testConnectionRefused)
+{
+    // Bind a port, then release it so nobody listens there.
+    net::IPAddress serverAddr;
+    {
+        net::Socket socket;
+        socket.open(AF_INET, SOCK_STREAM);
+        socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+        ::sockaddr_storage addrStorage;
+        ::socklen_t addrLen = sizeof(addrStorage);
+        const auto returnCode =
+            ::getsockname(socket.handle(),
+                          reinterpret_cast<::sockaddr*>(&addrStorage),
+                          &addrLen);
+        ASSERT_EQ(0, returnCode);
+        serverAddr = net::IPAddress(addrStorage, addrLen);
+    }
+
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto logger = logging::nullLogger();
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    AsyncHTTPTransporter transporter(
+        net::URI::parse(oss.str()), 0, 1, *logger, *metrics);
+    ASSERT_NO_THROW(transporter.emitBatch(makeBatch(3)));
+    transporter.close();
+
+    ASSERT_EQ(0, reportedSpans(stats, "success"));
+    ASSERT_EQ(3, reportedSpans(stats, "failure"));
+}
+
+TEST(AsyncHTTPTransporter, testRequestTimeout)
+{
+    // The kernel completes connections to a listening socket, but nobody
+    // accepts them, so no response ever comes.
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    socket.listen();
+
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    auto logger = logging::nullLogger();
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    {
+        AsyncHTTPTransporter transporter(net::URI::parse(oss.str()),
+                                         0,
+                                         1,
+                                         *logger,
+                                         *metrics,
+                                         nullptr,
+                                         std::chrono::milliseconds(50));
+        // The second batch waits for the first one to time out.
+        ASSERT_NO_THROW(transporter.emitBatch(makeBatch(2)));
+        ASSERT_NO_THROW(transporter.emitBatch(makeBatch(3)));
+        transporter.close();
+    }
+
+    ASSERT_EQ(0, reportedSpans(stats, "success"));
+    ASSERT_EQ(5, reportedSpans(stats, "failure"));
+}
+
+#endif  // __linux__
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/ChunkedTransport.h"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#ifndef WIN32
+#include <sys/uio.h>
+#endif
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr auto kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr auto kSendFlags = 0;
+#endif
+
+constexpr auto kDefaultChunkSize = 64 * 1024;
+constexpr auto kChunkEnd = "\r\n";
+constexpr auto kLastChunk = "0\r\n\r\n";
+constexpr auto kChunkEndAndLastChunk = "\r\n0\r\n\r\n";
+
+struct Buffer {
+    const char* _data;
+    size_t _size;
+};
+
+// Sends all of `buffers` in as few calls as the socket allows.
+template <size_t N>
+void sendAll(net::Socket& socket, std::array<Buffer, N>& buffers)
+{
+#ifdef WIN32
+    std::string message;
+    for (auto&& buffer : buffers) {
+        message.append(buffer._data, buffer._size);
+    }
+    size_t numWritten = 0;
+    while (numWritten < message.size()) {
+        const auto result = ::send(socket.handle(),
+                                   message.data() + numWritten,
+                                   static_cast<int>(message.size() - numWritten),
+                                   kSendFlags);
+        if (result < 0) {
+            throw std::system_error(WSAGetLastError(),
+                                    std::system_category(),
+                                    "Failed to write HTTP chunk");
+        }
+        numWritten += result;
+    }
+#else
+    std::array<::iovec, N> iov;
+    for (size_t i = 0; i < N; ++i) {
+        iov[i].iov_base = const_cast<char*>(buffers[i]._data);
+        iov[i].iov_len = buffers[i]._size;
+    }
+    auto* next = iov.data();
+    auto count = N;
+    while (count > 0) {
+        ::msghdr message = {};
+        message.msg_iov = next;
+        message.msg_iovlen = count;
+        auto result = ::sendmsg(socket.handle(), &message, kSendFlags);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(
+                errno, std::system_category(), "Failed to write HTTP chunk");
+        }
+        // Skips what was sent, including buffers that were empty to begin
+        // with.
+        while (count > 0 && static_cast<size_t>(result) >= next->iov_len) {
+            result -= next->iov_len;
+            ++next;
+            --count;
+        }
+        if (count > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + result;
+            next->iov_len -= result;
+        }
+    }
+#endif  // WIN32
+}
+
+}  // anonymous namespace
+
+ChunkedTransport::ChunkedTransport(int chunkSize)
+    : _socket(nullptr)
+    , _chunkSize(chunkSize > 0 ? chunkSize : kDefaultChunkSize)
+    , _head()
+    , _chunk()
+{
+}
+
+void ChunkedTransport::begin(net::Socket& socket, const std::string& head)
+{
+    _socket = &socket;
+    _head = head;
+    _chunk.clear();
+}
+
+void ChunkedTransport::write(const uint8_t* data, uint32_t size)
+{
+    if (_chunk.size() + size <= _chunkSize) {
+        _chunk.append(reinterpret_cast<const char*>(data), size);
+        return;
+    }
+    if (!_chunk.empty()) {
+        sendChunk(reinterpret_cast<const uint8_t*>(_chunk.data()),
+                  static_cast<uint32_t>(_chunk.size()),
+                  kChunkEnd);
+        _chunk.clear();
+    }
+    if (size >= _chunkSize) {
+        sendChunk(data, size, kChunkEnd);
+    }
+    else {
+        _chunk.append(reinterpret_cast<const char*>(data), size);
+    }
+}
+
+void ChunkedTransport::end()
+{
+    // The last chunk shares a send with the end of the body, so that it is
+    // not held back waiting for the acknowledgement of earlier segments.
+    sendChunk(reinterpret_cast<const uint8_t*>(_chunk.data()),
+              static_cast<uint32_t>(_chunk.size()),
+              _chunk.empty() ? kLastChunk : kChunkEndAndLastChunk);
+    _chunk.clear();
+    _socket = nullptr;
+}
+
+void ChunkedTransport::sendChunk(const uint8_t* data,
+                                 uint32_t size,
+                                 const char* trailer)
+{
+    if (!_socket) {
+        throw std::logic_error("No request started on chunked transport");
+    }
+    std::array<char, 16> sizeLine;
+    auto sizeLineLength = 0;
+    if (size > 0) {
+        sizeLineLength = std::snprintf(
+            sizeLine.data(), sizeLine.size(), "%x\r\n", size);
+    }
+    std::array<Buffer, 4> buffers = {
+        { { _head.data(), _head.size() },
+          { sizeLine.data(), static_cast<size_t>(sizeLineLength) },
+          { reinterpret_cast<const char*>(data), size },
+          { trailer, std::strlen(trailer) } }
+    };
+    sendAll(*_socket, buffers);
+    _head.clear();
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_CHUNKEDTRANSPORT_H
+#define JAEGERTRACING_UTILS_CHUNKEDTRANSPORT_H
+
+#include <cstdint>
+#include <string>
+
+#include <thrift/transport/TVirtualTransport.h>
+
+#include "jaegertracing/net/Socket.h"
+
+namespace jaegertracing {
+namespace utils {
+
+// Sends what a protocol writes to it straight to a socket, as the body of
+// an HTTP request with chunked transfer encoding. Small writes are gathered
+// into chunks of up to `chunkSize` bytes; larger ones are sent as chunks of
+// their own without being copied.
+class ChunkedTransport
+    : public apache::thrift::transport::TVirtualTransport<ChunkedTransport> {
+  public:
+    explicit ChunkedTransport(int chunkSize);
+
+    bool isOpen() override { return _socket != nullptr; }
+
+    void open() override {}
+
+    void close() override { _socket = nullptr; }
+
+    // Starts a request on `socket`. The request line and headers in `head`
+    // are sent along with the first chunk.
+    void begin(net::Socket& socket, const std::string& head);
+
+    void write(const uint8_t* data, uint32_t size);
+
+    // Sends the last chunks and ends the body.
+    void end();
+
+  private:
+    // Sends the pending head, `size` bytes at `data` as one chunk unless
+    // `size` is 0, then `trailer`.
+    void sendChunk(const uint8_t* data, uint32_t size, const char* trailer);
+
+    net::Socket* _socket;
+    size_t _chunkSize;
+    std::string _head;
+    std::string _chunk;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_CHUNKEDTRANSPORT_H
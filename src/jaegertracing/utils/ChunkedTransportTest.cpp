@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/ChunkedTransport.h"
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(ChunkedTransport, testChunks)
+{
+    net::Socket server;
+    server.open(AF_INET, SOCK_STREAM);
+    server.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        server.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    server.listen();
+
+    std::string received;
+    std::thread serverThread([&server, &received]() {
+        auto client = server.accept();
+        char buffer[256];
+        while (true) {
+            const auto numRead =
+                ::recv(client.handle(), buffer, sizeof(buffer), 0);
+            if (numRead <= 0) {
+                break;
+            }
+            received.append(buffer, numRead);
+        }
+    });
+
+    {
+        net::Socket socket;
+        socket.open(AF_INET, SOCK_STREAM);
+        socket.connect(serverAddr);
+
+        ChunkedTransport transport(8);
+        const std::string small("abc");
+        const std::string large("0123456789abcdef0123");
+        const auto write = [&transport](const std::string& str) {
+            transport.write(reinterpret_cast<const uint8_t*>(str.data()),
+                            static_cast<uint32_t>(str.size()));
+        };
+        transport.begin(socket, "HEAD\r\n\r\n");
+        write(small);
+        write(small);
+        // Sent on its own, after what was gathered so far.
+        write(large);
+        write(small);
+        transport.end();
+
+        // Nothing written, only the last chunk.
+        transport.begin(socket, "HEAD\r\n\r\n");
+        transport.end();
+    }
+    serverThread.join();
+
+    ASSERT_EQ(std::string("HEAD\r\n\r\n"
+                          "6\r\nabcabc\r\n"
+                          "14\r\n0123456789abcdef0123\r\n"
+                          "3\r\nabc\r\n"
+                          "0\r\n\r\n"
+                          "HEAD\r\n\r\n"
+                          "0\r\n\r\n"),
+              received);
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
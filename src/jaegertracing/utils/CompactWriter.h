@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_UTILS_COMPACTWRITER_H
+#define JAEGERTRACING_UTILS_COMPACTWRITER_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <opentracing/string_view.h>
+
+namespace jaegertracing {
+namespace utils {
+
+// Appends Thrift compact protocol encodings to a string, producing the same
+// bytes as TCompactProtocol would for the same sequence of calls. Lets the
+// tracer's own types encode themselves without first building the generated
+// thrift types; nothing is allocated once the string has enough capacity.
+class CompactWriter {
+  public:
+    enum class Type : uint8_t {
+        kBoolTrue = 1,
+        kBoolFalse = 2,
+        kByte = 3,
+        kI16 = 4,
+        kI32 = 5,
+        kI64 = 6,
+        kDouble = 7,
+        kBinary = 8,
+        kList = 9,
+        kSet = 10,
+        kMap = 11,
+        kStruct = 12
+    };
+
+    explicit CompactWriter(std::string& buffer)
+        : _buffer(buffer)
+        , _lastFieldId(0)
+    {
+    }
+
+    CompactWriter(const CompactWriter&) = delete;
+
+    CompactWriter& operator=(const CompactWriter&) = delete;
+
+    // Returns the state to pass to the matching writeStructEnd().
+    int16_t writeStructBegin()
+    {
+        const auto lastFieldId = _lastFieldId;
+        _lastFieldId = 0;
+        return lastFieldId;
+    }
+
+    // Writes the field stop marker and goes back to the enclosing struct.
+    void writeStructEnd(int16_t lastFieldId)
+    {
+        writeByte(0);
+        _lastFieldId = lastFieldId;
+    }
+
+    void writeFieldBegin(Type type, int16_t id)
+    {
+        if (id > _lastFieldId && id - _lastFieldId <= 15) {
+            writeByte(
+                static_cast<uint8_t>((id - _lastFieldId) << 4) |
+                static_cast<uint8_t>(type));
+        }
+        else {
+            writeByte(static_cast<uint8_t>(type));
+            writeI16(id);
+        }
+        _lastFieldId = id;
+    }
+
+    void writeListBegin(Type elementType, uint32_t size)
+    {
+        if (size <= 14) {
+            writeByte(static_cast<uint8_t>(size << 4) |
+                      static_cast<uint8_t>(elementType));
+        }
+        else {
+            writeByte(0xf0 | static_cast<uint8_t>(elementType));
+            writeVarint32(size);
+        }
+    }
+
+    void writeI16(int16_t value) { writeI32(value); }
+
+    void writeI32(int32_t value)
+    {
+        writeVarint32((static_cast<uint32_t>(value) << 1) ^
+                      static_cast<uint32_t>(value >> 31));
+    }
+
+    void writeI64(int64_t value)
+    {
+        writeVarint64((static_cast<uint64_t>(value) << 1) ^
+                      static_cast<uint64_t>(value >> 63));
+    }
+
+    void writeDouble(double value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (auto i = 0; i < 8; ++i) {
+            writeByte(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    void writeString(opentracing::string_view value)
+    {
+        writeVarint32(static_cast<uint32_t>(value.size()));
+        _buffer.append(value.data(), value.size());
+    }
+
+    void writeBoolField(int16_t id, bool value)
+    {
+        writeFieldBegin(value ? Type::kBoolTrue : Type::kBoolFalse, id);
+    }
+
+    void writeI32Field(int16_t id, int32_t value)
+    {
+        writeFieldBegin(Type::kI32, id);
+        writeI32(value);
+    }
+
+    void writeI64Field(int16_t id, int64_t value)
+    {
+        writeFieldBegin(Type::kI64, id);
+        writeI64(value);
+    }
+
+    void writeDoubleField(int16_t id, double value)
+    {
+        writeFieldBegin(Type::kDouble, id);
+        writeDouble(value);
+    }
+
+    void writeStringField(int16_t id, opentracing::string_view value)
+    {
+        writeFieldBegin(Type::kBinary, id);
+        writeString(value);
+    }
+
+    void writeListField(int16_t id, Type elementType, uint32_t size)
+    {
+        writeFieldBegin(Type::kList, id);
+        writeListBegin(elementType, size);
+    }
+
+  private:
+    void writeByte(uint8_t value)
+    {
+        _buffer.push_back(static_cast<char>(value));
+    }
+
+    void writeVarint32(uint32_t value)
+    {
+        while ((value & ~0x7fu) != 0) {
+            writeByte(static_cast<uint8_t>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        writeByte(static_cast<uint8_t>(value));
+    }
+
+    void writeVarint64(uint64_t value)
+    {
+        while ((value & ~0x7full) != 0) {
+            writeByte(static_cast<uint8_t>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        writeByte(static_cast<uint8_t>(value));
+    }
+
+    std::string& _buffer;
+    int16_t _lastFieldId;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_COMPACTWRITER_H
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/Compressor.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "jaegertracing/Constants.h"
+
+#ifdef JAEGERTRACING_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef JAEGERTRACING_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+#ifdef JAEGERTRACING_WITH_ZLIB
+// Window bits for a gzip rather than a zlib wrapper.
+constexpr auto kGzipWindowBits = 15 + 16;
+constexpr auto kGzipMemLevel = 8;
+#endif
+
+}  // anonymous namespace
+
+constexpr int Compressor::kDefaultLevel;
+
+bool Compressor::available(Compression compression)
+{
+    switch (compression) {
+    case Compression::kNone: {
+        return true;
+    }
+    case Compression::kGzip: {
+#ifdef JAEGERTRACING_WITH_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    }
+    case Compression::kZstd: {
+#ifdef JAEGERTRACING_WITH_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    }
+    return false;
+}
+
+Compressor::Compressor(Compression compression,
+                       int level,
+                       metrics::Metrics& metrics)
+    : _compression(compression)
+    , _level(level)
+    , _metrics(metrics)
+    , _context(nullptr)
+{
+    if (!available(compression)) {
+        throw std::invalid_argument(
+            "Compression codec not available in this build");
+    }
+}
+
+Compressor::~Compressor()
+{
+    if (!_context) {
+        return;
+    }
+#ifdef JAEGERTRACING_WITH_ZLIB
+    if (_compression == Compression::kGzip) {
+        auto* stream = static_cast<z_stream*>(_context);
+        ::deflateEnd(stream);
+        delete stream;
+    }
+#endif
+#ifdef JAEGERTRACING_WITH_ZSTD
+    if (_compression == Compression::kZstd) {
+        ::ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(_context));
+    }
+#endif
+}
+
+const char* Compressor::contentEncoding() const
+{
+    switch (_compression) {
+    case Compression::kGzip: {
+        return "gzip";
+    }
+    case Compression::kZstd: {
+        return "zstd";
+    }
+    default: {
+        return "";
+    }
+    }
+}
+
+void Compressor::compress(const uint8_t* data,
+                          size_t size,
+                          std::string& output)
+{
+    switch (_compression) {
+    case Compression::kGzip: {
+        compressGzip(data, size, output);
+    } break;
+    case Compression::kZstd: {
+        compressZstd(data, size, output);
+    } break;
+    default: {
+        output.assign(reinterpret_cast<const char*>(data), size);
+    } break;
+    }
+    _metrics.reporterBytesUncompressed().inc(size);
+    _metrics.reporterBytesCompressed().inc(output.size());
+}
+
+void Compressor::compressGzip(const uint8_t* data,
+                              size_t size,
+                              std::string& output)
+{
+#ifdef JAEGERTRACING_WITH_ZLIB
+    auto* stream = static_cast<z_stream*>(_context);
+    if (!stream) {
+        stream = new z_stream();
+        const auto level = (_level > 0) ? std::min(_level, Z_BEST_COMPRESSION)
+                                        : Z_DEFAULT_COMPRESSION;
+        if (::deflateInit2(stream,
+                           level,
+                           Z_DEFLATED,
+                           kGzipWindowBits,
+                           kGzipMemLevel,
+                           Z_DEFAULT_STRATEGY) != Z_OK) {
+            delete stream;
+            throw std::runtime_error("Failed to initialize gzip stream");
+        }
+        _context = stream;
+    }
+    else {
+        ::deflateReset(stream);
+    }
+
+    output.resize(::deflateBound(stream, static_cast<uLong>(size)));
+    stream->next_in = const_cast<Bytef*>(data);
+    stream->avail_in = static_cast<uInt>(size);
+    stream->next_out = reinterpret_cast<Bytef*>(&output[0]);
+    stream->avail_out = static_cast<uInt>(output.size());
+    if (::deflate(stream, Z_FINISH) != Z_STREAM_END) {
+        throw std::runtime_error("Failed to gzip HTTP request body");
+    }
+    output.resize(stream->total_out);
+#else
+    (void)data;
+    (void)size;
+    (void)output;
+#endif
+}
+
+void Compressor::compressZstd(const uint8_t* data,
+                              size_t size,
+                              std::string& output)
+{
+#ifdef JAEGERTRACING_WITH_ZSTD
+    auto* context = static_cast<ZSTD_CCtx*>(_context);
+    if (!context) {
+        context = ::ZSTD_createCCtx();
+        if (!context) {
+            throw std::runtime_error("Failed to create zstd context");
+        }
+        _context = context;
+    }
+
+    output.resize(::ZSTD_compressBound(size));
+    const auto result = ::ZSTD_compressCCtx(
+        context, &output[0], output.size(), data, size, _level);
+    if (::ZSTD_isError(result)) {
+        throw std::runtime_error(
+            std::string("Failed to zstd compress HTTP request body: ") +
+            ::ZSTD_getErrorName(result));
+    }
+    output.resize(result);
+#else
+    (void)data;
+    (void)size;
+    (void)output;
+#endif
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_COMPRESSOR_H
+#define JAEGERTRACING_UTILS_COMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "jaegertracing/metrics/Metrics.h"
+
+namespace jaegertracing {
+namespace utils {
+
+// Content encoding of the batches posted to the collector.
+enum class Compression { kNone, kGzip, kZstd };
+
+// Compresses HTTP request bodies, reusing its compression context from one
+// body to the next. gzip and zstd are only available when the library was
+// built with JAEGERTRACING_WITH_ZLIB or JAEGERTRACING_WITH_ZSTD.
+class Compressor {
+  public:
+    // Level 0 picks the codec's default level.
+    static constexpr auto kDefaultLevel = 0;
+
+    // Whether support for `compression` was built in.
+    static bool available(Compression compression);
+
+    // Counts the bytes before and after compression in `metrics`.
+    Compressor(Compression compression, int level, metrics::Metrics& metrics);
+
+    ~Compressor();
+
+    Compressor(const Compressor&) = delete;
+
+    Compressor& operator=(const Compressor&) = delete;
+
+    Compression compression() const { return _compression; }
+
+    // The Content-Encoding header value, empty for Compression::kNone.
+    const char* contentEncoding() const;
+
+    // Replaces the contents of `output` with the `size` bytes at `data`,
+    // compressed.
+    void compress(const uint8_t* data, size_t size, std::string& output);
+
+  private:
+    void compressGzip(const uint8_t* data, size_t size, std::string& output);
+
+    void compressZstd(const uint8_t* data, size_t size, std::string& output);
+
+    Compression _compression;
+    int _level;
+    metrics::Metrics& _metrics;
+    // z_stream or ZSTD_CCtx, created on first use.
+    void* _context;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_COMPRESSOR_H
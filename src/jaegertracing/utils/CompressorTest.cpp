@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/Compressor.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "jaegertracing/Constants.h"
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
+
+#ifdef JAEGERTRACING_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef JAEGERTRACING_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+int64_t reportedBytes(const metrics::InMemoryStatsReporter& stats,
+                      const std::string& state)
+{
+    const auto itr = stats.counters().find(
+        metrics::Metrics::addTagsToMetricName("jaeger.reporter-bytes",
+                                              { { "state", state } }));
+    return (itr == std::end(stats.counters())) ? 0 : itr->second;
+}
+
+// Repeats operation names and tag keys like a batch of spans does.
+std::string makeBody()
+{
+    std::string body;
+    for (auto i = 0; i < 100; ++i) {
+        body += "GET /api/users";
+        body += "http.status_code";
+        body += std::to_string(200 + i % 3);
+    }
+    return body;
+}
+
+const uint8_t* bytes(const std::string& str)
+{
+    return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+}  // anonymous namespace
+
+TEST(Compressor, testNone)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    Compressor compressor(Compression::kNone, 0, *metrics);
+    ASSERT_EQ(std::string(), compressor.contentEncoding());
+
+    const auto body = makeBody();
+    std::string output;
+    compressor.compress(bytes(body), body.size(), output);
+    ASSERT_EQ(body, output);
+    ASSERT_EQ(static_cast<int64_t>(body.size()),
+              reportedBytes(stats, "uncompressed"));
+    ASSERT_EQ(static_cast<int64_t>(body.size()),
+              reportedBytes(stats, "compressed"));
+}
+
+TEST(Compressor, testUnavailable)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    for (auto compression : { Compression::kGzip, Compression::kZstd }) {
+        if (Compressor::available(compression)) {
+            ASSERT_NO_THROW(Compressor(compression, 0, *metrics));
+        }
+        else {
+            ASSERT_THROW(Compressor(compression, 0, *metrics),
+                         std::invalid_argument);
+        }
+    }
+}
+
+#ifdef JAEGERTRACING_WITH_ZLIB
+
+TEST(Compressor, testGzip)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    Compressor compressor(Compression::kGzip, 9, *metrics);
+    ASSERT_EQ(std::string("gzip"), compressor.contentEncoding());
+
+    const auto body = makeBody();
+    std::string output;
+    // The second body reuses the stream of the first.
+    for (auto i = 0; i < 2; ++i) {
+        compressor.compress(bytes(body), body.size(), output);
+        ASSERT_LT(output.size(), body.size() / 4);
+
+        z_stream stream = {};
+        ASSERT_EQ(Z_OK, ::inflateInit2(&stream, 15 + 16));
+        std::string decompressed(body.size(), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(&output[0]);
+        stream.avail_in = static_cast<uInt>(output.size());
+        stream.next_out = reinterpret_cast<Bytef*>(&decompressed[0]);
+        stream.avail_out = static_cast<uInt>(decompressed.size());
+        ASSERT_EQ(Z_STREAM_END, ::inflate(&stream, Z_FINISH));
+        ASSERT_EQ(body.size(), stream.total_out);
+        ::inflateEnd(&stream);
+        ASSERT_EQ(body, decompressed);
+    }
+    ASSERT_EQ(static_cast<int64_t>(2 * body.size()),
+              reportedBytes(stats, "uncompressed"));
+    ASSERT_EQ(static_cast<int64_t>(2 * output.size()),
+              reportedBytes(stats, "compressed"));
+}
+
+#endif  // JAEGERTRACING_WITH_ZLIB
+
+#ifdef JAEGERTRACING_WITH_ZSTD
+
+TEST(Compressor, testZstd)
+{
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    Compressor compressor(Compression::kZstd, 0, *metrics);
+    ASSERT_EQ(std::string("zstd"), compressor.contentEncoding());
+
+    const auto body = makeBody();
+    std::string output;
+    compressor.compress(bytes(body), body.size(), output);
+    ASSERT_LT(output.size(), body.size() / 4);
+
+    std::string decompressed(body.size(), '\0');
+    const auto size = ::ZSTD_decompress(
+        &decompressed[0], decompressed.size(), output.data(), output.size());
+    ASSERT_FALSE(::ZSTD_isError(size));
+    ASSERT_EQ(body.size(), size);
+    ASSERT_EQ(body, decompressed);
+    ASSERT_EQ(static_cast<int64_t>(output.size()),
+              reportedBytes(stats, "compressed"));
+}
+
+#endif  // JAEGERTRACING_WITH_ZSTD
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -20,6 +20,10 @@
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
 
 namespace jaegertracing {
 namespace utils {
@@ -45,6 +49,30 @@ inline std::pair<bool, int> getIntVariable(const char* envVar)
     return std::make_pair(false, 0);
 }
 
+// Parses a byte count that may not fit in an int. The first member is false
+// when the variable is unset, negative or not a number.
+inline std::pair<bool, size_t> getSizeVariable(const char* envVar)
+{
+    const auto rawVariable = std::getenv(envVar);
+    const std::string variable(rawVariable ? rawVariable : "");
+    const auto first = std::find_if(
+        variable.begin(), variable.end(), [](char ch) {
+            return !std::isspace(static_cast<unsigned char>(ch));
+        });
+    if (first == variable.end() || *first == '-') {
+        return std::make_pair(false, 0);
+    }
+    try {
+        const auto value = std::stoull(variable);
+        if (value <= std::numeric_limits<size_t>::max()) {
+            return std::make_pair(true, static_cast<size_t>(value));
+        }
+    } catch (const std::logic_error&) {
+        // Not a number, or out of range.
+    }
+    return std::make_pair(false, 0);
+}
+
 inline std::pair<bool, bool> getBoolVariable(const char* envVar)
 {
     const auto rawVariable = std::getenv(envVar);
@@ -15,29 +15,253 @@
  */
 
 #include "jaegertracing/utils/HTTPTransporter.h"
+#include "jaegertracing/net/http/Request.h"
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/protocol/TProtocol.h>
 
 namespace jaegertracing {
 namespace utils {
 
-HTTPTransporter::HTTPTransporter(const net::URI& endpoint, int maxPacketSize)
+namespace {
+
+#ifdef MSG_NOSIGNAL
+// A collector closing the connection must not raise SIGPIPE.
+constexpr auto kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr auto kSendFlags = 0;
+#endif
+
+constexpr auto kContentType = "application/x-thrift";
+
+}  // anonymous namespace
+
+HTTPTransporter::HTTPTransporter(
+    const net::URI& endpoint,
+    int maxPacketSize,
+    const std::shared_ptr<net::http::ConnectionPool>& connections,
+    std::unique_ptr<Compressor>&& compressor,
+    int chunkSize,
+    IOBackend ioBackend)
     : Transport(maxPacketSize == 0 ? kHttpPacketMaxLength : maxPacketSize)
-    , _buffer(new apache::thrift::transport::TMemoryBuffer(_maxPacketSize))
-    , _serverAddr(net::IPAddress::v4(endpoint._host, endpoint._port))
-    , _httpClient(new ::apache::thrift::transport::THttpClient(
-        _buffer, endpoint._host, endpoint._path + "?format=jaeger.thrift"))
+    // The buffer grows as needed, large batch sizes are not reserved up
+    // front.
+    , _buffer(new apache::thrift::transport::TMemoryBuffer(
+          _maxPacketSize < kHttpPacketMaxLength ? _maxPacketSize
+                                                : kHttpPacketMaxLength))
+    , _connections(connections
+                       ? connections
+                       : std::make_shared<net::http::ConnectionPool>(
+                             net::IPAddress::v4(endpoint._host,
+                                                endpoint._port)))
+    , _host(endpoint.authority())
+    , _target(endpoint._path + "?format=jaeger.thrift")
+    , _compressor(std::move(compressor))
+    , _chunked()
+    , _chunkedProtocol()
+#ifdef __linux__
+    , _ring()
+    , _received()
+#endif
 {
     using TProtocolFactory = apache::thrift::protocol::TProtocolFactory;
     using TBinaryProtocolFactory =
         apache::thrift::protocol::TBinaryProtocolFactory;
 
-    _socket.open(AF_INET, SOCK_STREAM);
-    _socket.connect(_serverAddr);
     std::shared_ptr<TProtocolFactory> protocolFactory(
         new TBinaryProtocolFactory());
-    _protocol = protocolFactory->getProtocol(_httpClient);
+    _protocol = protocolFactory->getProtocol(_buffer);
+    if (chunkSize > 0 && !_compressor) {
+        _chunked = std::make_shared<ChunkedTransport>(chunkSize);
+        _chunkedProtocol = protocolFactory->getProtocol(_chunked);
+    }
+
+#ifdef __linux__
+    if (ioBackend == IOBackend::kIOUring && !_chunked &&
+        IOUring::available()) {
+        try {
+            _ring.reset(new IOUring(2));
+        } catch (const std::system_error&) {
+            // Out of locked memory for the ring, use send() and recv().
+        }
+    }
+#else
+    (void)ioBackend;
+#endif
+}
+
+void HTTPTransporter::emitBatch(const thrift::Batch& batch)
+{
+    send([&batch](apache::thrift::protocol::TProtocol& protocol) {
+        batch.write(&protocol);
+    });
+}
+
+void HTTPTransporter::emitSerializedBatch(const std::string& process,
+                                          const std::string& spans,
+                                          int numSpans)
+{
+    send([&process, &spans, numSpans](
+             apache::thrift::protocol::TProtocol& protocol) {
+        writeSerializedBatch(protocol, process, spans, numSpans);
+    });
+}
+
+void HTTPTransporter::send(const WriteBatch& writeBatch)
+{
+    if (_chunked) {
+        // Encoded bytes go out as they are written, so a failed attempt
+        // encodes the batch again for the next one.
+        const auto head =
+            net::http::formatChunkedPostHead(_host, _target, kContentType);
+        post([this, &head, &writeBatch](
+                 net::http::ConnectionPool::Connection& connection) {
+            _chunked->begin(connection._socket, head);
+            writeBatch(*_chunkedProtocol);
+            _chunked->end();
+        });
+        return;
+    }
+
+    _buffer->resetBuffer();
+    writeBatch(*_protocol);
+
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    _buffer->getBuffer(&data, &size);
+
+    const char* contentEncoding = "";
+    if (_compressor) {
+        _compressor->compress(data, size, _compressed);
+        data = reinterpret_cast<uint8_t*>(&_compressed[0]);
+        size = static_cast<uint32_t>(_compressed.size());
+        contentEncoding = _compressor->contentEncoding();
+    }
+    _message = net::http::formatPostHead(
+        _host, _target, kContentType, size, contentEncoding);
+    _message.append(reinterpret_cast<const char*>(data), size);
+    post([this](net::http::ConnectionPool::Connection& connection) {
+        sendMessage(connection);
+    });
+}
+
+void HTTPTransporter::post(const SendRequest& sendRequest)
+{
+    auto connection = _connections->acquire();
+    auto reusable = false;
+    net::http::Response response;
+    try {
+        response = request(*connection, sendRequest, reusable);
+    } catch (...) {
+        if (!connection->_reused) {
+            throw;
+        }
+        // The collector may have closed the idle connection in the
+        // meantime, try once more on a new one.
+        connection = _connections->connect();
+        response = request(*connection, sendRequest, reusable);
+    }
+    if (reusable) {
+        _connections->release(std::move(connection));
+    }
+
+    // Check that the server acknowledged and returned a green status.
+    if (response.statusCode() < 200 || response.statusCode() > 299) {
+        std::ostringstream oss;
+        oss << "Failed to write message, HTTP error " << response.statusCode()
+            << ' ' << response.reason();
+        throw std::runtime_error(oss.str());
+    }
+}
+
+net::http::Response
+HTTPTransporter::request(net::http::ConnectionPool::Connection& connection,
+                         const SendRequest& sendRequest,
+                         bool& reusable)
+{
+    sendRequest(connection);
+
+    // Waits for the response, framed by its headers so that the
+    // connection can carry the next batch.
+    return net::http::read(connection._socket, connection._pending, reusable);
+}
+
+void HTTPTransporter::sendMessage(
+    net::http::ConnectionPool::Connection& connection)
+{
+#ifdef __linux__
+    if (_ring && submitMessage(connection)) {
+        return;
+    }
+#endif
+    auto& socket = connection._socket;
+    const auto* data = _message.data();
+    const auto size = static_cast<uint32_t>(_message.size());
+    uint32_t numWritten = 0;
+    while (numWritten < size) {
+        const auto result = ::send(
+            socket.handle(), data + numWritten, size - numWritten, kSendFlags);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::ostringstream oss;
+            oss << "Failed to write message, numWritten=" << numWritten
+                << ", size=" << size;
+            throw std::system_error(errno, std::system_category(), oss.str());
+        }
+        numWritten += static_cast<uint32_t>(result);
+    }
+}
+
+#ifdef __linux__
+bool HTTPTransporter::submitMessage(
+    net::http::ConnectionPool::Connection& connection)
+{
+    enum Operation : uint64_t { kSend, kReceive };
+
+    // Most responses fit, net::http::read() receives the rest.
+    constexpr auto kReceiveSize = 4096;
+    _received.resize(kReceiveSize);
+    const auto handle = connection._socket.handle();
+    _ring->queueSend(handle,
+                     _message.data(),
+                     _message.size(),
+                     kSendFlags | MSG_WAITALL,
+                     true,
+                     kSend);
+    _ring->queueRecv(handle, &_received[0], _received.size(), kReceive);
+    _ring->submit(2);
+
+    auto numWritten = 0;
+    auto numRead = 0;
+    uint64_t operation = 0;
+    auto result = 0;
+    while (_ring->complete(operation, result)) {
+        (operation == kSend ? numWritten : numRead) = result;
+    }
+    if (numWritten == -EINVAL || numWritten == -EOPNOTSUPP) {
+        // Kernel without sends through io_uring, use send() and recv() from
+        // now on.
+        _ring.reset();
+        return false;
+    }
+    if (numWritten < 0 ||
+        static_cast<size_t>(numWritten) != _message.size()) {
+        std::ostringstream oss;
+        oss << "Failed to write message, numWritten=" << numWritten
+            << ", size=" << _message.size();
+        throw std::system_error(numWritten < 0 ? -numWritten : EIO,
+                                std::system_category(),
+                                oss.str());
+    }
+    if (numRead < 0) {
+        throw std::system_error(
+            -numRead, std::system_category(), "Failed to read response");
+    }
+    connection._pending.append(_received, 0, numRead);
+    return true;
 }
+#endif
 
 }  // namespace utils
 }  // namespace jaegertracing
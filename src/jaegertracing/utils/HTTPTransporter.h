@@ -17,6 +17,7 @@
 #ifndef JAEGERTRACING_UTILS_UDPCLIENT5_H
 #define JAEGERTRACING_UTILS_UDPCLIENT5_H
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -24,59 +25,48 @@
 
 #include "jaegertracing/Compilers.h"
 
+#include "jaegertracing/utils/ChunkedTransport.h"
+#include "jaegertracing/utils/Compressor.h"
+#include "jaegertracing/utils/IOUring.h"
 #include "jaegertracing/utils/Transport.h"
 
 #include "jaegertracing/net/IPAddress.h"
 #include "jaegertracing/net/Socket.h"
+#include "jaegertracing/net/http/ConnectionPool.h"
 #include "jaegertracing/net/http/Response.h"
 
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TBufferTransports.h>
-#include <thrift/transport/THttpClient.h>
 
 namespace jaegertracing {
 namespace utils {
 
 class HTTPTransporter : public Transport {
   public:
-    HTTPTransporter(const net::URI& endpoint, int maxPacketSize);
+    // Transporters may share `connections` to the collector; by default
+    // each has a pool of its own. Request bodies are compressed with
+    // `compressor` when it is set. Otherwise, a `chunkSize` above 0 streams
+    // each batch to the collector with chunked transfer encoding while it
+    // is encoded, rather than encoding it to memory first. Batches encoded
+    // to memory are sent, and the response awaited, with one io_uring
+    // submission with IOBackend::kIOUring, where available.
+    HTTPTransporter(const net::URI& endpoint,
+                    int maxPacketSize,
+                    const std::shared_ptr<net::http::ConnectionPool>&
+                        connections = nullptr,
+                    std::unique_ptr<Compressor>&& compressor = nullptr,
+                    int chunkSize = 0,
+                    IOBackend ioBackend = IOBackend::kSockets);
 
     ~HTTPTransporter() { close(); }
 
-    void emitBatch(const thrift::Batch& batch) override
-    {
-        // Resets the buffer to write a new batch
-        _buffer->resetBuffer();
-
-        // Does the serialisation to Thrift
-        auto oprot = _protocol.get();
-        batch.write(oprot);
-        oprot->writeMessageEnd();
-        oprot->getTransport()->writeEnd();
-        oprot->getTransport()->flush();
-
-        uint8_t* data = nullptr;
-        uint32_t size = 0;
-        _buffer->getBuffer(&data, &size);
-
-        // Sends the HTTP message
-        const auto numWritten = ::send(_socket.handle(), reinterpret_cast<char*>(data), sizeof(uint8_t) * size, 0);
-
-        if (static_cast<unsigned>(numWritten) != size) {
-            std::ostringstream oss;
-            oss << "Failed to write message, numWritten=" << numWritten << ", size=" << size;
-            throw std::system_error(errno, std::system_category(), oss.str());
-        }
-
-        // Waits for response. Check that the server acknowledged
-        // and returned a green status [200, 201, 202, 203, 204]
-        net::http::Response response = net::http::read(_socket);
-        if (response.statusCode() < 200 && response.statusCode() > 204) {
-          std::ostringstream oss;
-          oss << "Failed to write message, HTTP error " << response.statusCode() << response.reason();
-          throw std::system_error(errno, std::system_category(), oss.str());
-        }
-    }
+    void emitBatch(const thrift::Batch& batch) override;
+
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override;
+
+    bool streamsBatches() const override { return static_cast<bool>(_chunked); }
 
     std::unique_ptr<apache::thrift::protocol::TProtocolFactory>
     protocolFactory() const override
@@ -86,10 +76,47 @@ class HTTPTransporter : public Transport {
     }
 
   private:
+    using WriteBatch =
+        std::function<void(apache::thrift::protocol::TProtocol& protocol)>;
+
+    using SendRequest = std::function<void(
+        net::http::ConnectionPool::Connection& connection)>;
+
+    // Posts the batch written by `writeBatch` and waits for the response.
+    void send(const WriteBatch& writeBatch);
+
+    // Sends a request with `sendRequest`, on a new connection again if the
+    // collector closed the one it was sent on, and checks the response.
+    void post(const SendRequest& sendRequest);
+
+    net::http::Response request(net::http::ConnectionPool::Connection& connection,
+                                const SendRequest& sendRequest,
+                                bool& reusable);
+
+    // Sends the HTTP message in _message.
+    void sendMessage(net::http::ConnectionPool::Connection& connection);
+
+#ifdef __linux__
+    // Sends _message through _ring, linked to a receive of the start of the
+    // response into the connection's pending bytes. Returns false, having
+    // sent nothing, if the kernel turns out not to support it.
+    bool submitMessage(net::http::ConnectionPool::Connection& connection);
+#endif
+
     std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _buffer;
-    net::IPAddress _serverAddr;
-    std::shared_ptr<::apache::thrift::transport::THttpClient> _httpClient;
+    std::shared_ptr<net::http::ConnectionPool> _connections;
     std::shared_ptr<apache::thrift::protocol::TProtocol> _protocol;
+    std::string _host;
+    std::string _target;
+    std::unique_ptr<Compressor> _compressor;
+    std::string _compressed;
+    std::string _message;
+    std::shared_ptr<ChunkedTransport> _chunked;
+    std::shared_ptr<apache::thrift::protocol::TProtocol> _chunkedProtocol;
+#ifdef __linux__
+    std::unique_ptr<IOUring> _ring;
+    std::string _received;
+#endif
 
     static constexpr auto kHttpPacketMaxLength = 1024 * 1024; // 1MB
 };
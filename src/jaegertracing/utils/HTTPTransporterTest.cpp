@@ -25,12 +25,18 @@
 #include <string>
 #include <utility>
 
+#include "jaegertracing/Constants.h"
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
 #include "jaegertracing/net/Socket.h"
 #include "jaegertracing/net/http/Request.h"
 #include "jaegertracing/net/http/Response.h"
 #include <future>
 #include <thread>
 
+#ifdef JAEGERTRACING_WITH_ZLIB
+#include <zlib.h>
+#endif
+
 namespace jaegertracing {
 
 namespace utils {
@@ -109,5 +115,196 @@ TEST(HTTPTransporter, testSpanReporting)
     ASSERT_EQ(std::string("application/x-thrift"), acceptType);
 }
 
+namespace {
+
+void testKeepAliveAndReconnect(IOBackend ioBackend)
+{
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    socket.listen();
+
+    std::promise<void> closed;
+    auto closedFuture = closed.get_future();
+    auto numRequests = 0;
+    std::thread serverThread([&socket, &closed, &numRequests]() {
+        const std::string answer(
+            "HTTP/1.1 202 Accepted\r\nContent-Length: 0\r\n\r\n");
+        {
+            // Two requests on the first connection, then it goes away as
+            // if the collector restarted.
+            auto clientSocket = socket.accept();
+            for (auto i = 0; i < 2; ++i) {
+                net::http::Request::read(clientSocket);
+                ++numRequests;
+                ::send(clientSocket.handle(), answer.c_str(), answer.size(), 0);
+            }
+        }
+        closed.set_value();
+
+        auto clientSocket = socket.accept();
+        net::http::Request::read(clientSocket);
+        ++numRequests;
+        ::send(clientSocket.handle(), answer.c_str(), answer.size(), 0);
+    });
+
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    HTTPTransporter transporter(
+        net::URI::parse(oss.str()), 0, nullptr, nullptr, 0, ioBackend);
+    thrift::Batch batch;
+    batch.process.__set_serviceName("test-service");
+
+    ASSERT_NO_THROW(transporter.emitBatch(batch));
+    ASSERT_NO_THROW(transporter.emitBatch(batch));
+    closedFuture.wait();
+    ASSERT_NO_THROW(transporter.emitBatch(batch));
+
+    serverThread.join();
+    ASSERT_EQ(3, numRequests);
+}
+
+}  // anonymous namespace
+
+TEST(HTTPTransporter, testKeepAliveAndReconnect)
+{
+    testKeepAliveAndReconnect(IOBackend::kSockets);
+}
+
+TEST(HTTPTransporter, testIOUring)
+{
+    // Also passes, on sockets, where io_uring is not available.
+    testKeepAliveAndReconnect(IOBackend::kIOUring);
+}
+
+TEST(HTTPTransporter, testChunkedUpload)
+{
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    socket.listen();
+
+    std::string head;
+    std::string body;
+    std::thread serverThread([&socket, &head, &body]() {
+        auto clientSocket = socket.accept();
+        std::string received;
+        char buffer[256];
+        while (received.find("\r\n0\r\n\r\n") == std::string::npos) {
+            const auto numRead =
+                ::recv(clientSocket.handle(), buffer, sizeof(buffer), 0);
+            if (numRead <= 0) {
+                return;
+            }
+            received.append(buffer, numRead);
+        }
+        auto pos = received.find("\r\n\r\n") + 4;
+        head = received.substr(0, pos);
+        while (true) {
+            const auto lineEnd = received.find("\r\n", pos);
+            const auto size =
+                std::stoul(received.substr(pos, lineEnd - pos), nullptr, 16);
+            if (size == 0) {
+                break;
+            }
+            body += received.substr(lineEnd + 2, size);
+            pos = lineEnd + 2 + size + 2;
+        }
+        const std::string answer(
+            "HTTP/1.1 202 Accepted\r\nContent-Length: 0\r\n\r\n");
+        ::send(clientSocket.handle(), answer.c_str(), answer.size(), 0);
+    });
+
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    HTTPTransporter transporter(
+        net::URI::parse(oss.str()), 0, nullptr, nullptr, 8);
+    thrift::Batch batch;
+    batch.process.__set_serviceName("test-service");
+    ASSERT_NO_THROW(transporter.emitBatch(batch));
+    serverThread.join();
+
+    auto expected =
+        std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    batch.write(transporter.protocolFactory()->getProtocol(expected).get());
+    ASSERT_NE(std::string::npos, head.find("Transfer-Encoding: chunked\r\n"));
+    ASSERT_EQ(std::string::npos, head.find("Content-Length"));
+    ASSERT_EQ(expected->getBufferAsString(), body);
+}
+
+#ifdef JAEGERTRACING_WITH_ZLIB
+
+TEST(HTTPTransporter, testGzipBody)
+{
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_STREAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+    socket.listen();
+
+    std::string contentEncoding;
+    std::string body;
+    std::thread serverThread([&socket, &contentEncoding, &body]() {
+        auto clientSocket = socket.accept();
+        const auto request = net::http::Request::read(clientSocket);
+        for (auto&& header : request.headers()) {
+            if (header.key() == "Content-Encoding") {
+                contentEncoding = header.value();
+            }
+        }
+        body = request.body();
+        const std::string answer(
+            "HTTP/1.1 202 Accepted\r\nContent-Length: 0\r\n\r\n");
+        ::send(clientSocket.handle(), answer.c_str(), answer.size(), 0);
+    });
+
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    std::ostringstream oss;
+    oss << "http://127.0.0.1:" << serverAddr.port() << "/api/traces";
+    HTTPTransporter transporter(
+        net::URI::parse(oss.str()),
+        0,
+        nullptr,
+        std::unique_ptr<Compressor>(
+            new Compressor(Compression::kGzip, 0, *metrics)));
+    thrift::Batch batch;
+    batch.process.__set_serviceName("test-service");
+    ASSERT_NO_THROW(transporter.emitBatch(batch));
+    serverThread.join();
+
+    ASSERT_EQ(std::string("gzip"), contentEncoding);
+    z_stream stream = {};
+    ASSERT_EQ(Z_OK, ::inflateInit2(&stream, 15 + 16));
+    std::string decompressed(1024, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(&body[0]);
+    stream.avail_in = static_cast<uInt>(body.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&decompressed[0]);
+    stream.avail_out = static_cast<uInt>(decompressed.size());
+    ASSERT_EQ(Z_STREAM_END, ::inflate(&stream, Z_FINISH));
+    decompressed.resize(stream.total_out);
+    ::inflateEnd(&stream);
+    ASSERT_NE(std::string::npos, decompressed.find("test-service"));
+}
+
+#endif  // JAEGERTRACING_WITH_ZLIB
+
 }  // namespace utils
 }  // namespace jaegertracing
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/IOUring.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include "jaegertracing/Constants.h"
+
+#ifdef JAEGERTRACING_WITH_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace jaegertracing {
+namespace utils {
+
+#ifdef JAEGERTRACING_WITH_IO_URING
+
+namespace {
+
+// First feature flag of Linux 6.3; older headers lack it.
+constexpr unsigned kFeatureRegisteredRing = 1U << 13;
+
+int setup(unsigned entries, ::io_uring_params& params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(::syscall(
+        __NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+unsigned* at(void* ring, unsigned offset)
+{
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+}
+
+void* map(int fd, size_t size, off_t offset)
+{
+    void* const mapping = ::mmap(nullptr,
+                                 size,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE,
+                                 fd,
+                                 offset);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(
+            errno, std::system_category(), "Failed to map io_uring");
+    }
+    return mapping;
+}
+
+}  // anonymous namespace
+
+bool IOUring::available()
+{
+    static const auto result = []() {
+        ::io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const auto fd = setup(1, params);
+        if (fd < 0) {
+            return false;
+        }
+        ::close(fd);
+        return (params.features & IORING_FEAT_SINGLE_MMAP) != 0 &&
+               (params.features & kFeatureRegisteredRing) != 0;
+    }();
+    return result;
+}
+
+IOUring::IOUring(unsigned entries)
+    : _fd(-1)
+    , _sqEntries(0)
+    , _toSubmit(0)
+    , _sqRing(nullptr)
+    , _sqRingSize(0)
+    , _cqRing(nullptr)
+    , _cqRingSize(0)
+    , _sqes(nullptr)
+    , _sqesSize(0)
+    , _sqHead(nullptr)
+    , _sqTail(nullptr)
+    , _sqQueuedTail(0)
+    , _sqMask(0)
+    , _sqArray(nullptr)
+    , _cqHead(nullptr)
+    , _cqTail(nullptr)
+    , _cqMask(0)
+    , _cqes(nullptr)
+{
+    ::io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    _fd = setup(entries, params);
+    if (_fd < 0) {
+        throw std::system_error(
+            errno, std::system_category(), "Failed to set up io_uring");
+    }
+    _sqEntries = params.sq_entries;
+
+    try {
+        // One mapping holds both rings since Linux 5.4, which available()
+        // checks for.
+        _sqRingSize =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        _cqRingSize =
+            params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+        if (_cqRingSize > _sqRingSize) {
+            _sqRingSize = _cqRingSize;
+        }
+        _sqRing = map(_fd, _sqRingSize, IORING_OFF_SQ_RING);
+        _cqRing = _sqRing;
+        _sqesSize = params.sq_entries * sizeof(::io_uring_sqe);
+        _sqes = map(_fd, _sqesSize, IORING_OFF_SQES);
+    } catch (...) {
+        if (_sqRing) {
+            ::munmap(_sqRing, _sqRingSize);
+        }
+        ::close(_fd);
+        throw;
+    }
+
+    _sqHead = at(_sqRing, params.sq_off.head);
+    _sqTail = at(_sqRing, params.sq_off.tail);
+    _sqQueuedTail = *_sqTail;
+    _sqMask = *at(_sqRing, params.sq_off.ring_mask);
+    _sqArray = at(_sqRing, params.sq_off.array);
+    _cqHead = at(_cqRing, params.cq_off.head);
+    _cqTail = at(_cqRing, params.cq_off.tail);
+    _cqMask = *at(_cqRing, params.cq_off.ring_mask);
+    _cqes = static_cast<char*>(_cqRing) + params.cq_off.cqes;
+}
+
+IOUring::~IOUring()
+{
+    ::munmap(_sqes, _sqesSize);
+    ::munmap(_sqRing, _sqRingSize);
+    ::close(_fd);
+}
+
+bool IOUring::queueSendmsg(
+    int fd, const ::msghdr* message, int flags, bool link, uint64_t userData)
+{
+    auto* sqe = static_cast<::io_uring_sqe*>(queue(userData));
+    if (!sqe) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(message);
+    sqe->len = 1;
+    sqe->msg_flags = static_cast<uint32_t>(flags);
+    sqe->flags = link ? IOSQE_IO_LINK : 0;
+    return true;
+}
+
+bool IOUring::queueSend(int fd,
+                        const void* data,
+                        size_t size,
+                        int flags,
+                        bool link,
+                        uint64_t userData)
+{
+    auto* sqe = static_cast<::io_uring_sqe*>(queue(userData));
+    if (!sqe) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data);
+    sqe->len = static_cast<uint32_t>(size);
+    sqe->msg_flags = static_cast<uint32_t>(flags);
+    sqe->flags = link ? IOSQE_IO_LINK : 0;
+    return true;
+}
+
+bool IOUring::queueRecv(int fd, void* buffer, size_t size, uint64_t userData)
+{
+    auto* sqe = static_cast<::io_uring_sqe*>(queue(userData));
+    if (!sqe) {
+        return false;
+    }
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buffer);
+    sqe->len = static_cast<uint32_t>(size);
+    return true;
+}
+
+void IOUring::submit(unsigned numCompletions)
+{
+    // The queued entries are complete now, hand them to the kernel.
+    __atomic_store_n(_sqTail, _sqQueuedTail, __ATOMIC_RELEASE);
+    while (_toSubmit > 0 || ready() < numCompletions) {
+        const auto result =
+            enter(_fd,
+                  _toSubmit,
+                  numCompletions,
+                  numCompletions > 0 ? IORING_ENTER_GETEVENTS : 0);
+        if (result >= 0) {
+            _toSubmit -= static_cast<unsigned>(result);
+        }
+        else if (errno != EINTR) {
+            throw std::system_error(
+                errno, std::system_category(), "Failed to submit to io_uring");
+        }
+    }
+}
+
+bool IOUring::complete(uint64_t& userData, int& result)
+{
+    const auto head = *_cqHead;
+    if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    const auto& cqe = static_cast<const ::io_uring_cqe*>(_cqes)[head & _cqMask];
+    userData = cqe.user_data;
+    result = cqe.res;
+    __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void* IOUring::queue(uint64_t userData)
+{
+    // The caller fills in the entry, so the tail the kernel reads is only
+    // advanced by submit().
+    const auto tail = _sqQueuedTail;
+    if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) {
+        return nullptr;
+    }
+    const auto index = tail & _sqMask;
+    auto* sqe = static_cast<::io_uring_sqe*>(_sqes) + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = userData;
+    _sqArray[index] = index;
+    _sqQueuedTail = tail + 1;
+    ++_toSubmit;
+    return sqe;
+}
+
+unsigned IOUring::ready() const
+{
+    return __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE) - *_cqHead;
+}
+
+#else
+
+bool IOUring::available() { return false; }
+
+IOUring::IOUring(unsigned)
+{
+    throw std::system_error(
+        ENOSYS,
+        std::system_category(),
+        "io_uring support requires building with JAEGERTRACING_WITH_IO_URING");
+}
+
+IOUring::~IOUring() {}
+
+bool IOUring::queueSendmsg(int, const ::msghdr*, int, bool, uint64_t)
+{
+    return false;
+}
+
+bool IOUring::queueSend(int, const void*, size_t, int, bool, uint64_t)
+{
+    return false;
+}
+
+bool IOUring::queueRecv(int, void*, size_t, uint64_t) { return false; }
+
+void IOUring::submit(unsigned) {}
+
+bool IOUring::complete(uint64_t&, int&) { return false; }
+
+#endif  // JAEGERTRACING_WITH_IO_URING
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // __linux__
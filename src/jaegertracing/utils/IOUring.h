@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_IOURING_H
+#define JAEGERTRACING_UTILS_IOURING_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace jaegertracing {
+namespace utils {
+
+// How transporters make their socket system calls.
+enum class IOBackend { kSockets, kIOUring };
+
+#ifdef __linux__
+
+// A minimal io_uring instance, driven through the raw system calls, for
+// queueing several socket operations and submitting them, and waiting for
+// their completions, with one system call. Not thread-safe; each transporter
+// owns its own. Only works when the library was built with
+// JAEGERTRACING_WITH_IO_URING.
+class IOUring {
+  public:
+    // Whether a ring can be set up: support is built in and the kernel, or a
+    // seccomp policy in front of it, allows it. Rings are only used from
+    // Linux 6.3, which retries short sends flagged MSG_WAITALL, so that a
+    // receive linked to a send never waits for a request cut short.
+    static bool available();
+
+    // Throws std::system_error if the kernel refuses to set up a ring with
+    // room for `entries` queued operations.
+    explicit IOUring(unsigned entries);
+
+    ~IOUring();
+
+    IOUring(const IOUring&) = delete;
+
+    IOUring& operator=(const IOUring&) = delete;
+
+    // Number of operations that may be queued before submit().
+    unsigned capacity() const { return _sqEntries; }
+
+    // Queue an operation, returning false if the ring is full. With `link`,
+    // the next operation queued only starts once this one succeeded, and
+    // completes with -ECANCELED otherwise. `userData` is handed back with
+    // the completion.
+    bool queueSendmsg(int fd,
+                      const ::msghdr* message,
+                      int flags,
+                      bool link,
+                      uint64_t userData);
+
+    bool queueSend(int fd,
+                   const void* data,
+                   size_t size,
+                   int flags,
+                   bool link,
+                   uint64_t userData);
+
+    bool queueRecv(int fd, void* buffer, size_t size, uint64_t userData);
+
+    // Submits the queued operations and waits until at least
+    // `numCompletions` completions are ready. Throws std::system_error if
+    // the kernel rejects the submission.
+    void submit(unsigned numCompletions);
+
+    // Takes a ready completion. `result` holds what the system call would
+    // have returned, or the negated errno.
+    bool complete(uint64_t& userData, int& result);
+
+  private:
+    void* queue(uint64_t userData);
+
+    unsigned ready() const;
+
+    int _fd;
+    unsigned _sqEntries;
+    unsigned _toSubmit;
+    void* _sqRing;
+    size_t _sqRingSize;
+    void* _cqRing;
+    size_t _cqRingSize;
+    void* _sqes;
+    size_t _sqesSize;
+    unsigned* _sqHead;
+    unsigned* _sqTail;
+    // Tail of the entries queued so far, published to _sqTail on submit().
+    unsigned _sqQueuedTail;
+    unsigned _sqMask;
+    unsigned* _sqArray;
+    unsigned* _cqHead;
+    unsigned* _cqTail;
+    unsigned _cqMask;
+    void* _cqes;
+};
+
+#endif  // __linux__
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_IOURING_H
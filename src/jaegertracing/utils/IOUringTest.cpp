@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/utils/IOUring.h"
+
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(IOUring, testLinkedSendAndRecv)
+{
+    if (!IOUring::available()) {
+        ASSERT_THROW(IOUring(2), std::system_error);
+        return;
+    }
+
+    int sockets[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    std::thread echoThread([&sockets]() {
+        char buffer[16];
+        const auto numRead = ::read(sockets[1], buffer, sizeof(buffer));
+        if (numRead > 0) {
+            ::write(sockets[1], buffer, numRead);
+        }
+    });
+
+    IOUring ring(2);
+    ASSERT_EQ(2U, ring.capacity());
+    const std::string message("hello");
+    char buffer[16];
+    ASSERT_TRUE(ring.queueSend(
+        sockets[0], message.c_str(), message.size(), MSG_WAITALL, true, 1));
+    ASSERT_TRUE(ring.queueRecv(sockets[0], buffer, sizeof(buffer), 2));
+    ASSERT_FALSE(ring.queueRecv(sockets[0], buffer, sizeof(buffer), 3));
+    ring.submit(2);
+
+    uint64_t userData = 0;
+    auto result = 0;
+    ASSERT_TRUE(ring.complete(userData, result));
+    ASSERT_EQ(1U, userData);
+    ASSERT_EQ(static_cast<int>(message.size()), result);
+    ASSERT_TRUE(ring.complete(userData, result));
+    ASSERT_EQ(2U, userData);
+    ASSERT_EQ(static_cast<int>(message.size()), result);
+    ASSERT_FALSE(ring.complete(userData, result));
+    ASSERT_EQ(message, std::string(buffer, result));
+
+    echoThread.join();
+    ::close(sockets[0]);
+    ::close(sockets[1]);
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // __linux__
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_OPTIONALMUTEX_H
+#define JAEGERTRACING_UTILS_OPTIONALMUTEX_H
+
+#include <cassert>
+#include <mutex>
+#include <thread>
+
+namespace jaegertracing {
+namespace utils {
+
+// A mutex that can be turned off for objects only ever used by one thread.
+// When disabled, locking does nothing; debug builds instead check that it is
+// locked from the thread that constructed it, so sharing such an object
+// across threads trips an assertion rather than racing silently.
+class OptionalMutex {
+  public:
+    explicit OptionalMutex(bool enabled = true)
+        : _mutex()
+        , _enabled(enabled)
+        , _owner(std::this_thread::get_id())
+    {
+    }
+
+    OptionalMutex(const OptionalMutex&) = delete;
+
+    OptionalMutex& operator=(const OptionalMutex&) = delete;
+
+    bool enabled() const { return _enabled; }
+
+    void lock()
+    {
+        if (_enabled) {
+            _mutex.lock();
+        }
+        else {
+            checkOwner();
+        }
+    }
+
+    bool try_lock()
+    {
+        if (_enabled) {
+            return _mutex.try_lock();
+        }
+        checkOwner();
+        return true;
+    }
+
+    void unlock()
+    {
+        if (_enabled) {
+            _mutex.unlock();
+        }
+    }
+
+  private:
+    void checkOwner() const
+    {
+        assert(std::this_thread::get_id() == _owner &&
+               "single-owner object used from another thread");
+        (void)_owner;
+    }
+
+    std::mutex _mutex;
+    bool _enabled;
+    // Kept in release builds too, so that the layout of the objects holding
+    // this mutex does not depend on NDEBUG.
+    std::thread::id _owner;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_OPTIONALMUTEX_H
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/OptionalMutex.h"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(OptionalMutex, testEnabled)
+{
+    OptionalMutex mutex;
+    ASSERT_TRUE(mutex.enabled());
+    std::unique_lock<OptionalMutex> lock(mutex);
+    std::thread thread([&mutex]() { ASSERT_FALSE(mutex.try_lock()); });
+    thread.join();
+}
+
+TEST(OptionalMutex, testDisabled)
+{
+    OptionalMutex mutex(false);
+    ASSERT_FALSE(mutex.enabled());
+    std::lock_guard<OptionalMutex> lock(mutex);
+    // Locking again does not deadlock, nothing is held.
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+#ifndef NDEBUG
+
+TEST(OptionalMutex, testDisabledFromOtherThread)
+{
+    ASSERT_DEATH(
+        {
+            OptionalMutex mutex(false);
+            std::thread thread([&mutex]() { mutex.lock(); });
+            thread.join();
+        },
+        "another thread");
+}
+
+#endif  // NDEBUG
+
+}  // namespace utils
+}  // namespace jaegertracing
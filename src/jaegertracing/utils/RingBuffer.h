@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JAEGERTRACING_UTILS_RINGBUFFER_H
+#define JAEGERTRACING_UTILS_RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace jaegertracing {
+namespace utils {
+
+// Bounded lock-free queue based on Dmitry Vyukov's MPMC ring buffer. Every
+// slot carries a sequence number that tells producers and consumers whether
+// it is free or filled, so `tryPush` and `tryPop` only contend on a single
+// CAS of their own position counter and never take a lock. `tryPush` fails
+// instead of blocking when the buffer is full.
+template <typename T>
+class RingBuffer {
+  public:
+    explicit RingBuffer(size_t capacity)
+        : _capacity(capacity > 0 ? capacity : 1)
+        , _cells(new Cell[_capacity])
+        , _enqueuePos(0)
+        , _dequeuePos(0)
+    {
+        for (size_t i = 0; i < _capacity; ++i) {
+            _cells[i]._sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t capacity() const { return _capacity; }
+
+    bool tryPush(T&& value)
+    {
+        Cell* cell = nullptr;
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos % _capacity];
+            const auto sequence =
+                cell->_sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // Slot still holds a value from the previous lap: full.
+                return false;
+            }
+            else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->_value = std::move(value);
+        cell->_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes as many values of [first, last) as there are consecutive free
+    // slots, claiming all of them with a single CAS. Returns the number of
+    // values pushed; those are moved from, the rest are left untouched.
+    template <typename Iterator>
+    size_t tryPushBatch(Iterator first, Iterator last)
+    {
+        const auto count = static_cast<uint64_t>(std::distance(first, last));
+        if (count == 0) {
+            return 0;
+        }
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+        uint64_t claimed = 0;
+        while (true) {
+            claimed = 0;
+            while (claimed < count && claimed < _capacity) {
+                const auto& cell = _cells[(pos + claimed) % _capacity];
+                const auto sequence =
+                    cell._sequence.load(std::memory_order_acquire);
+                if (sequence != pos + claimed) {
+                    break;
+                }
+                ++claimed;
+            }
+            if (claimed > 0) {
+                // A free slot only changes state once a producer claims its
+                // position, which would fail this CAS.
+                if (_enqueuePos.compare_exchange_weak(
+                        pos, pos + claimed, std::memory_order_relaxed)) {
+                    break;
+                }
+                continue;
+            }
+            const auto sequence =
+                _cells[pos % _capacity]._sequence.load(
+                    std::memory_order_acquire);
+            if (static_cast<int64_t>(sequence) - static_cast<int64_t>(pos) <
+                0) {
+                return 0;
+            }
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+        for (uint64_t i = 0; i < claimed; ++i, ++first) {
+            auto& cell = _cells[(pos + i) % _capacity];
+            cell._value = std::move(*first);
+            cell._sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return static_cast<size_t>(claimed);
+    }
+
+    bool tryPop(T& value)
+    {
+        Cell* cell = nullptr;
+        auto pos = _dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos % _capacity];
+            const auto sequence =
+                cell->_sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // Slot not yet filled by a producer: empty.
+                return false;
+            }
+            else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->_value);
+        cell->_sequence.store(pos + _capacity, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate number of queued values; exact only when no push or pop is
+    // in progress.
+    size_t size() const
+    {
+        const auto dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+        const auto enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+        return (enqueuePos > dequeuePos)
+                   ? static_cast<size_t>(enqueuePos - dequeuePos)
+                   : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+  private:
+    static constexpr auto kCacheLineSize = 64;
+
+    struct Cell {
+        std::atomic<uint64_t> _sequence;
+        T _value;
+    };
+
+    using PositionType = std::atomic<uint64_t>;
+
+    const size_t _capacity;
+    std::unique_ptr<Cell[]> _cells;
+    // Keep producer and consumer positions on separate cache lines so they do
+    // not invalidate each other.
+    char _padding0[kCacheLineSize];
+    PositionType _enqueuePos;
+    char _padding1[kCacheLineSize - sizeof(PositionType)];
+    PositionType _dequeuePos;
+    char _padding2[kCacheLineSize - sizeof(PositionType)];
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_RINGBUFFER_H
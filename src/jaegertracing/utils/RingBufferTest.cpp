@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/utils/RingBuffer.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(RingBuffer, testPushPop)
+{
+    RingBuffer<std::unique_ptr<int>> buffer(3);
+    ASSERT_TRUE(buffer.empty());
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_TRUE(buffer.tryPush(std::unique_ptr<int>(new int(i))));
+    }
+    ASSERT_EQ(3, buffer.size());
+    ASSERT_FALSE(buffer.tryPush(std::unique_ptr<int>(new int(3))));
+
+    std::unique_ptr<int> value;
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_TRUE(buffer.tryPop(value));
+        ASSERT_EQ(i, *value);
+    }
+    ASSERT_FALSE(buffer.tryPop(value));
+    ASSERT_TRUE(buffer.empty());
+
+    // Wrap around a few times with a capacity that is not a power of two.
+    for (auto i = 0; i < 10; ++i) {
+        ASSERT_TRUE(buffer.tryPush(std::unique_ptr<int>(new int(i))));
+        ASSERT_TRUE(buffer.tryPop(value));
+        ASSERT_EQ(i, *value);
+    }
+}
+
+TEST(RingBuffer, testPushBatch)
+{
+    RingBuffer<std::unique_ptr<int>> buffer(5);
+    std::vector<std::unique_ptr<int>> values;
+    for (auto i = 0; i < 3; ++i) {
+        values.emplace_back(new int(i));
+    }
+    ASSERT_EQ(3, buffer.tryPushBatch(values.begin(), values.end()));
+    ASSERT_EQ(3, buffer.size());
+
+    // Only two slots are left, the remaining value stays with the caller.
+    values.clear();
+    for (auto i = 3; i < 6; ++i) {
+        values.emplace_back(new int(i));
+    }
+    ASSERT_EQ(2, buffer.tryPushBatch(values.begin(), values.end()));
+    ASSERT_FALSE(values[1]);
+    ASSERT_TRUE(values[2]);
+    ASSERT_EQ(5, *values[2]);
+    ASSERT_EQ(0, buffer.tryPushBatch(values.begin() + 2, values.end()));
+
+    std::unique_ptr<int> value;
+    for (auto i = 0; i < 5; ++i) {
+        ASSERT_TRUE(buffer.tryPop(value));
+        ASSERT_EQ(i, *value);
+    }
+    ASSERT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, testConcurrentProducers)
+{
+    constexpr auto kNumProducers = 4;
+    constexpr auto kNumValues = 10000;
+    RingBuffer<int> buffer(128);
+
+    std::vector<std::thread> producers;
+    for (auto i = 0; i < kNumProducers; ++i) {
+        producers.emplace_back([&buffer]() {
+            for (auto j = 0; j < kNumValues; ++j) {
+                while (!buffer.tryPush(1)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto sum = 0;
+    auto value = 0;
+    while (sum < kNumProducers * kNumValues) {
+        if (buffer.tryPop(value)) {
+            sum += value;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto&& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(kNumProducers * kNumValues, sum);
+    ASSERT_TRUE(buffer.empty());
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
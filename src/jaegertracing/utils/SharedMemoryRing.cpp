@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/SharedMemoryRing.h"
+
+#ifndef WIN32
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "Ring positions must be lock-free to be shared between "
+              "processes");
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+constexpr auto kShmScheme = "shm://";
+
+constexpr uint64_t kMagic = 0x4a41454752494e47ULL;  // "JAEGRING"
+
+// Written in place of a length where the next record would not fit before
+// the end of the data area; the record starts over at its beginning.
+constexpr uint32_t kWrapMarker = 0xffffffff;
+
+constexpr size_t kAlignment = 8;
+
+size_t align(size_t size)
+{
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // anonymous namespace
+
+constexpr size_t SharedMemoryRing::kMinCapacity;
+constexpr size_t SharedMemoryRing::kLengthSize;
+
+bool SharedMemoryRing::parseAddress(const std::string& address,
+                                    std::string& path)
+{
+    const std::string scheme(kShmScheme);
+    if (address.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+    path = address.substr(scheme.size());
+    return true;
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string& path, size_t capacity)
+    : _path(path)
+    , _capacity(capacity & ~(kAlignment - 1))
+    , _mapping(MAP_FAILED)
+    , _mappingSize(0)
+    , _header(nullptr)
+    , _data(nullptr)
+    , _writeMutex()
+{
+    const auto dataOffset = align(sizeof(Header));
+    const auto fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::ostringstream oss;
+        oss << "Failed to open shared memory ring " << _path;
+        throw std::system_error(errno, std::system_category(), oss.str());
+    }
+
+    struct ::stat stat;
+    if (::fstat(fd, &stat) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(
+            error, std::system_category(), "Failed to stat shared memory ring");
+    }
+    if (stat.st_size == 0) {
+        if (_capacity < kMinCapacity) {
+            ::close(fd);
+            std::ostringstream oss;
+            oss << "Shared memory ring capacity " << capacity
+                << " is below the minimum of " << kMinCapacity;
+            throw std::invalid_argument(oss.str());
+        }
+        if (::ftruncate(fd, dataOffset + _capacity) != 0) {
+            const auto error = errno;
+            ::close(fd);
+            throw std::system_error(error,
+                                    std::system_category(),
+                                    "Failed to size shared memory ring");
+        }
+    }
+    else {
+        const auto size = static_cast<size_t>(stat.st_size);
+        _capacity = size > dataOffset ? size - dataOffset : 0;
+        if (_capacity < kMinCapacity || _capacity % kAlignment != 0) {
+            ::close(fd);
+            std::ostringstream oss;
+            oss << "Invalid shared memory ring " << _path << ", size "
+                << size;
+            throw std::invalid_argument(oss.str());
+        }
+    }
+
+    _mappingSize = dataOffset + _capacity;
+    _mapping = ::mmap(
+        nullptr, _mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const auto error = errno;
+    ::close(fd);
+    if (_mapping == MAP_FAILED) {
+        throw std::system_error(
+            error, std::system_category(), "Failed to map shared memory ring");
+    }
+
+    _data = static_cast<uint8_t*>(_mapping) + dataOffset;
+    _header = static_cast<Header*>(_mapping);
+    if (_header->_magic.load(std::memory_order_acquire) != kMagic) {
+        // A new file is all zeros; set it up and publish it with the magic.
+        _header = new (_mapping) Header();
+        _header->_capacity = _capacity;
+        _header->_magic.store(kMagic, std::memory_order_release);
+    }
+    else if (_header->_capacity != _capacity) {
+        ::munmap(_mapping, _mappingSize);
+        std::ostringstream oss;
+        oss << "Invalid shared memory ring " << _path << ", capacity "
+            << _header->_capacity << " does not match its size";
+        throw std::invalid_argument(oss.str());
+    }
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (_mapping != MAP_FAILED) {
+        ::munmap(_mapping, _mappingSize);
+    }
+}
+
+bool SharedMemoryRing::write(const uint8_t* data, size_t size)
+{
+    if (size > maxRecordSize()) {
+        return false;
+    }
+    const auto recordSize = align(kLengthSize + size);
+
+    std::lock_guard<std::mutex> lock(_writeMutex);
+    // Only this process moves the write position.
+    auto position = _header->_writePosition.load(std::memory_order_relaxed);
+    const auto readPosition =
+        _header->_readPosition.load(std::memory_order_acquire);
+    auto offset = position % _capacity;
+    const auto padding =
+        (_capacity - offset < recordSize) ? _capacity - offset : 0;
+    if (position + padding + recordSize - readPosition > _capacity) {
+        return false;
+    }
+
+    if (padding > 0) {
+        std::memcpy(_data + offset, &kWrapMarker, kLengthSize);
+        position += padding;
+        offset = 0;
+    }
+    const auto length = static_cast<uint32_t>(size);
+    std::memcpy(_data + offset, &length, kLengthSize);
+    std::memcpy(_data + offset + kLengthSize, data, size);
+    _header->_writePosition.store(position + recordSize,
+                                  std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryRing::read(std::string& record)
+{
+    const auto readPosition =
+        _header->_readPosition.load(std::memory_order_relaxed);
+    auto position = readPosition;
+    const auto writePosition =
+        _header->_writePosition.load(std::memory_order_acquire);
+    auto found = false;
+    while (!found && position != writePosition) {
+        const auto offset = position % _capacity;
+        uint32_t length = 0;
+        std::memcpy(&length, _data + offset, kLengthSize);
+        if (length == kWrapMarker) {
+            position += _capacity - offset;
+            continue;
+        }
+        record.assign(reinterpret_cast<const char*>(_data + offset) +
+                          kLengthSize,
+                      length);
+        position += align(kLengthSize + length);
+        found = true;
+    }
+    if (position != readPosition) {
+        // Hands the space back to the producer.
+        _header->_readPosition.store(position, std::memory_order_release);
+    }
+    return found;
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
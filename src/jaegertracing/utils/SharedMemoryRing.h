@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_SHAREDMEMORYRING_H
+#define JAEGERTRACING_UTILS_SHAREDMEMORYRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace jaegertracing {
+namespace utils {
+
+// Declared on all platforms, so that callers may hold a null pointer to one
+// where it is not available.
+class SharedMemoryRing;
+
+#ifndef WIN32
+
+// A ring of length-prefixed records in a memory-mapped file, shared between
+// one producer process and one consumer process on the same host. Writes
+// from any thread of the producer are serialized with a mutex; reads must
+// come from a single thread of the consumer. Neither side makes a system
+// call per record; the consumer polls for new ones.
+//
+// The file holds a header, with a magic number, the capacity and the total
+// bytes each side has written and read, followed by the data area. Each
+// record there is a native-endian 32-bit length and that many bytes, padded
+// to a multiple of 8. A length of 0xffffffff marks the rest of the data
+// area as unused; the next record starts at its beginning.
+class SharedMemoryRing {
+  public:
+    static constexpr size_t kMinCapacity = 4096;
+
+    // Splits "shm:///path" into `path`. Returns false for other addresses.
+    static bool parseAddress(const std::string& address, std::string& path);
+
+    // Opens the ring file at `path`, creating it with room for `capacity`
+    // bytes of records if it does not exist yet. An existing file keeps its
+    // capacity and any records not consumed yet.
+    SharedMemoryRing(const std::string& path, size_t capacity);
+
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    // Appends one record. Returns false, writing nothing, if the consumer
+    // has not made room for it yet.
+    bool write(const uint8_t* data, size_t size);
+
+    // Takes the oldest record into `record`. Returns false if there is none.
+    bool read(std::string& record);
+
+    size_t capacity() const { return _capacity; }
+
+    // Largest record write() can ever fit.
+    size_t maxRecordSize() const { return _capacity / 2 - kLengthSize; }
+
+    const std::string& path() const { return _path; }
+
+  private:
+    static constexpr size_t kLengthSize = sizeof(uint32_t);
+
+    // Each side writes its own position on a separate cache line.
+    struct Header {
+        std::atomic<uint64_t> _magic;
+        uint64_t _capacity;
+        alignas(64) std::atomic<uint64_t> _writePosition;
+        alignas(64) std::atomic<uint64_t> _readPosition;
+    };
+
+    std::string _path;
+    size_t _capacity;
+    void* _mapping;
+    size_t _mappingSize;
+    Header* _header;
+    uint8_t* _data;
+    std::mutex _writeMutex;
+};
+
+#endif  // WIN32
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_SHAREDMEMORYRING_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/SharedMemoryRing.h"
+
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#ifndef WIN32
+
+#include <unistd.h>
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+std::string makePath(const std::string& name)
+{
+    const auto path = "/tmp/jaeger-ring-test-" + std::to_string(::getpid()) +
+                      '-' + name;
+    ::unlink(path.c_str());
+    return path;
+}
+
+bool write(SharedMemoryRing& ring, const std::string& record)
+{
+    return ring.write(reinterpret_cast<const uint8_t*>(record.data()),
+                      record.size());
+}
+
+}  // anonymous namespace
+
+TEST(SharedMemoryRing, testParseAddress)
+{
+    std::string path;
+    ASSERT_TRUE(SharedMemoryRing::parseAddress("shm:///dev/shm/spans", path));
+    ASSERT_EQ("/dev/shm/spans", path);
+    ASSERT_FALSE(SharedMemoryRing::parseAddress("127.0.0.1:6831", path));
+}
+
+TEST(SharedMemoryRing, testReadWrite)
+{
+    const auto path = makePath("read-write");
+    SharedMemoryRing producer(path, SharedMemoryRing::kMinCapacity);
+    // Another mapping of the same file, as the consumer process would have.
+    SharedMemoryRing consumer(path, 0);
+    ASSERT_EQ(SharedMemoryRing::kMinCapacity, consumer.capacity());
+
+    std::string record;
+    ASSERT_FALSE(consumer.read(record));
+    ASSERT_TRUE(write(producer, "first"));
+    ASSERT_TRUE(write(producer, ""));
+    ASSERT_TRUE(write(producer, "third"));
+    ASSERT_TRUE(consumer.read(record));
+    ASSERT_EQ("first", record);
+    ASSERT_TRUE(consumer.read(record));
+    ASSERT_EQ("", record);
+    ASSERT_TRUE(consumer.read(record));
+    ASSERT_EQ("third", record);
+    ASSERT_FALSE(consumer.read(record));
+    ::unlink(path.c_str());
+}
+
+TEST(SharedMemoryRing, testFullAndWrapAround)
+{
+    const auto path = makePath("wrap");
+    SharedMemoryRing ring(path, SharedMemoryRing::kMinCapacity);
+    const std::string big(ring.maxRecordSize(), 'b');
+    ASSERT_FALSE(write(ring, big + 'x'));
+
+    // Records that do not divide the capacity evenly end up wrapping.
+    const std::string medium(1000, 'm');
+    std::string record;
+    for (auto i = 0; i < 20; ++i) {
+        ASSERT_TRUE(write(ring, medium + std::to_string(i)));
+        ASSERT_TRUE(ring.read(record));
+        ASSERT_EQ(medium + std::to_string(i), record);
+    }
+
+    ASSERT_TRUE(write(ring, big));
+    ASSERT_FALSE(write(ring, big));
+    ASSERT_TRUE(ring.read(record));
+    ASSERT_EQ(big, record);
+    ASSERT_TRUE(write(ring, big));
+    ::unlink(path.c_str());
+}
+
+TEST(SharedMemoryRing, testReopen)
+{
+    const auto path = makePath("reopen");
+    {
+        SharedMemoryRing ring(path, 2 * SharedMemoryRing::kMinCapacity);
+        ASSERT_TRUE(write(ring, "kept"));
+    }
+    SharedMemoryRing ring(path, SharedMemoryRing::kMinCapacity);
+    ASSERT_EQ(2 * SharedMemoryRing::kMinCapacity, ring.capacity());
+    std::string record;
+    ASSERT_TRUE(ring.read(record));
+    ASSERT_EQ("kept", record);
+    ::unlink(path.c_str());
+
+    const auto smallPath = makePath("small");
+    ASSERT_THROW(SharedMemoryRing(smallPath, 16), std::invalid_argument);
+    ::unlink(smallPath.c_str());
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/SharedMemoryTransporter.h"
+
+#ifndef WIN32
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace jaegertracing {
+namespace utils {
+
+constexpr int SharedMemoryTransporter::kMaxBatchSize;
+
+SharedMemoryTransporter::SharedMemoryTransporter(
+    const std::shared_ptr<SharedMemoryRing>& ring)
+    : Transport(static_cast<int>(std::min<size_t>(ring->maxRecordSize(),
+                                                  kMaxBatchSize)))
+    , _ring(ring)
+    , _buffer(new apache::thrift::transport::TMemoryBuffer(_maxPacketSize))
+    , _protocol()
+{
+    _protocol = protocolFactory()->getProtocol(_buffer);
+}
+
+void SharedMemoryTransporter::emitBatch(const thrift::Batch& batch)
+{
+    _buffer->resetBuffer();
+    batch.write(_protocol.get());
+    writeBuffer(batch.spans.size());
+}
+
+void SharedMemoryTransporter::emitSerializedBatch(const std::string& process,
+                                                  const std::string& spans,
+                                                  int numSpans)
+{
+    _buffer->resetBuffer();
+    writeSerializedBatch(*_protocol, process, spans, numSpans);
+    writeBuffer(numSpans);
+}
+
+void SharedMemoryTransporter::writeBuffer(size_t numSpans)
+{
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    _buffer->getBuffer(&data, &size);
+    if (static_cast<int>(size) > _maxPacketSize) {
+        std::ostringstream oss;
+        oss << "Data does not fit within one record"
+               ", size "
+            << size << ", max " << _maxPacketSize << ", spans " << numSpans;
+        throw std::logic_error(oss.str());
+    }
+    if (!_ring->write(data, size)) {
+        std::ostringstream oss;
+        oss << "Shared memory ring " << _ring->path()
+            << " is full, size " << size << ", spans " << numSpans;
+        throw std::runtime_error(oss.str());
+    }
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
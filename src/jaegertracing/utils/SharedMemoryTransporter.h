@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_SHAREDMEMORYTRANSPORTER_H
+#define JAEGERTRACING_UTILS_SHAREDMEMORYTRANSPORTER_H
+
+#include <memory>
+#include <string>
+
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#include "jaegertracing/utils/SharedMemoryRing.h"
+#include "jaegertracing/utils/Transport.h"
+
+#ifndef WIN32
+
+namespace jaegertracing {
+namespace utils {
+
+// Writes each batch, encoded with the compact protocol, as one record of a
+// SharedMemoryRing polled by a consumer on the same host. Sending a batch
+// copies it into shared memory and makes no system call. Batches that find
+// the ring full fail, like a UDP packet the agent had no room for.
+class SharedMemoryTransporter : public Transport {
+  public:
+    // Keeps the encoding buffer of each transporter small however large the
+    // ring is.
+    static constexpr auto kMaxBatchSize = 1024 * 1024;
+
+    // Several transporters, one per sender thread, may share `ring`.
+    explicit SharedMemoryTransporter(
+        const std::shared_ptr<SharedMemoryRing>& ring);
+
+    void emitBatch(const thrift::Batch& batch) override;
+
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override;
+
+    std::unique_ptr<apache::thrift::protocol::TProtocolFactory>
+    protocolFactory() const override
+    {
+        return std::unique_ptr<apache::thrift::protocol::TProtocolFactory>(
+            new apache::thrift::protocol::TCompactProtocolFactory());
+    }
+
+  private:
+    void writeBuffer(size_t numSpans);
+
+    std::shared_ptr<SharedMemoryRing> _ring;
+    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _buffer;
+    std::shared_ptr<apache::thrift::protocol::TProtocol> _protocol;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
+
+#endif  // JAEGERTRACING_UTILS_SHAREDMEMORYTRANSPORTER_H
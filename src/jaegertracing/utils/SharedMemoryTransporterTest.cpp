@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/SharedMemoryTransporter.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+#include "jaegertracing/testutils/MockAgent.h"
+#include "jaegertracing/testutils/SharedMemoryConsumer.h"
+
+#ifndef WIN32
+
+#include <unistd.h>
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+std::string makePath(const std::string& name)
+{
+    const auto path = "/tmp/jaeger-shm-transporter-" +
+                      std::to_string(::getpid()) + '-' + name;
+    ::unlink(path.c_str());
+    return path;
+}
+
+}  // anonymous namespace
+
+TEST(SharedMemoryTransporter, testSendBatches)
+{
+    const auto path = makePath("send");
+    auto ring = std::make_shared<SharedMemoryRing>(path, 64 * 1024);
+    SharedMemoryTransporter transporter(ring);
+
+    apache::thrift::protocol::TCompactProtocolFactory protocolFactory;
+    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> buffer(
+        new apache::thrift::transport::TMemoryBuffer());
+    auto protocol = protocolFactory.getProtocol(buffer);
+    thrift::Process process;
+    process.__set_serviceName("test-service");
+    process.write(protocol.get());
+    const auto processBytes = buffer->getBufferAsString();
+    buffer->resetBuffer();
+    thrift::Span span;
+    span.__set_operationName("test");
+    span.write(protocol.get());
+    const auto spanBytes = buffer->getBufferAsString();
+
+    constexpr auto kNumBatches = 5;
+    std::vector<Transport::SerializedBatch> batches(kNumBatches);
+    for (auto&& batch : batches) {
+        batch._process = &processBytes;
+        batch._spans = &spanBytes;
+        batch._numSpans = 1;
+    }
+    size_t numSent = 0;
+    transporter.emitSerializedBatches(batches, numSent);
+    ASSERT_EQ(kNumBatches, static_cast<int>(numSent));
+    thrift::Batch batch;
+    batch.process = process;
+    batch.spans.push_back(span);
+    transporter.emitBatch(batch);
+
+    // The consumer maps the file on its own, as another process would.
+    auto mockAgent = testutils::MockAgent::make();
+    testutils::SharedMemoryConsumer consumer(
+        std::make_shared<SharedMemoryRing>(path, 0), mockAgent);
+    ASSERT_EQ(kNumBatches + 1, consumer.poll());
+
+    const auto received = mockAgent->batches();
+    ASSERT_EQ(kNumBatches + 1, static_cast<int>(received.size()));
+    for (auto&& batch : received) {
+        ASSERT_EQ("test-service", batch.process.serviceName);
+        ASSERT_EQ(1, static_cast<int>(batch.spans.size()));
+        ASSERT_EQ("test", batch.spans[0].operationName);
+    }
+    ::unlink(path.c_str());
+}
+
+TEST(SharedMemoryTransporter, testRingFull)
+{
+    const auto path = makePath("full");
+    auto ring = std::make_shared<SharedMemoryRing>(
+        path, SharedMemoryRing::kMinCapacity);
+    SharedMemoryTransporter transporter(ring);
+    ASSERT_EQ(static_cast<int>(ring->maxRecordSize()),
+              transporter.maxPacketSize());
+
+    const std::string process;
+    // Three of these do not fit.
+    const std::string spans(transporter.maxPacketSize() * 2 / 3, 's');
+    transporter.emitSerializedBatch(process, spans, 1);
+    transporter.emitSerializedBatch(process, spans, 1);
+    ASSERT_THROW(transporter.emitSerializedBatch(process, spans, 1),
+                 std::runtime_error);
+
+    std::string record;
+    ASSERT_TRUE(ring->read(record));
+    transporter.emitSerializedBatch(process, spans, 1);
+    ::unlink(path.c_str());
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_SMALLVECTOR_H
+#define JAEGERTRACING_UTILS_SMALLVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jaegertracing {
+namespace utils {
+
+// Vector that keeps its first N elements inside the object and only
+// allocates once it grows beyond them. Supports the subset of the
+// std::vector interface the span's members need; iterators are plain
+// pointers, invalidated like a vector's.
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs inline capacity");
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t kInlineCapacity = N;
+
+    SmallVector()
+        : _data(inlineData())
+        , _size(0)
+        , _capacity(N)
+    {
+    }
+
+    template <typename InputIterator,
+              typename = typename std::iterator_traits<
+                  InputIterator>::iterator_category>
+    SmallVector(InputIterator first, InputIterator last)
+        : SmallVector()
+    {
+        append(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> values)
+        : SmallVector()
+    {
+        append(values.begin(), values.end());
+    }
+
+    SmallVector(const SmallVector& other)
+        : SmallVector()
+    {
+        append(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+        : SmallVector()
+    {
+        moveFrom(other);
+    }
+
+    ~SmallVector()
+    {
+        destroy(begin(), end());
+        deallocate();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other) {
+            clear();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    void swap(SmallVector& other)
+    {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    iterator begin() { return _data; }
+
+    iterator end() { return _data + _size; }
+
+    const_iterator begin() const { return _data; }
+
+    const_iterator end() const { return _data + _size; }
+
+    const_iterator cbegin() const { return begin(); }
+
+    const_iterator cend() const { return end(); }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    size_t capacity() const { return _capacity; }
+
+    T* data() { return _data; }
+
+    const T* data() const { return _data; }
+
+    T& operator[](size_t index) { return _data[index]; }
+
+    const T& operator[](size_t index) const { return _data[index]; }
+
+    T& front() { return _data[0]; }
+
+    const T& front() const { return _data[0]; }
+
+    T& back() { return _data[_size - 1]; }
+
+    const T& back() const { return _data[_size - 1]; }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity > _capacity) {
+            reallocate(capacity);
+        }
+    }
+
+    void clear()
+    {
+        destroy(begin(), end());
+        _size = 0;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (_size < _capacity) {
+            new (_data + _size) T(std::forward<Args>(args)...);
+            ++_size;
+            return;
+        }
+        // Construct the new element before moving the others, in case the
+        // arguments refer to one of them.
+        const auto capacity = 2 * _capacity;
+        auto* data = allocate(capacity);
+        try {
+            new (data + _size) T(std::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(data);
+            throw;
+        }
+        moveTo(data, capacity);
+        ++_size;
+    }
+
+    void pop_back()
+    {
+        --_size;
+        _data[_size].~T();
+    }
+
+    template <typename InputIterator,
+              typename = typename std::iterator_traits<
+                  InputIterator>::iterator_category>
+    iterator insert(const_iterator position,
+                    InputIterator first,
+                    InputIterator last)
+    {
+        const auto offset = position - begin();
+        const auto oldSize = _size;
+        append(first, last);
+        std::rotate(begin() + offset, begin() + oldSize, end());
+        return begin() + offset;
+    }
+
+    template <typename InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        append(first, last);
+    }
+
+  private:
+    using Storage =
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    static T* allocate(size_t capacity)
+    {
+        return static_cast<T*>(::operator new(capacity * sizeof(T)));
+    }
+
+    static void destroy(T* first, T* last)
+    {
+        for (; first != last; ++first) {
+            first->~T();
+        }
+    }
+
+    T* inlineData() { return reinterpret_cast<T*>(_inline); }
+
+    bool isInline() const
+    {
+        return _data == reinterpret_cast<const T*>(_inline);
+    }
+
+    void deallocate()
+    {
+        if (!isInline()) {
+            ::operator delete(_data);
+        }
+    }
+
+    template <typename InputIterator>
+    void append(InputIterator first, InputIterator last)
+    {
+        appendRange(
+            first,
+            last,
+            typename std::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    template <typename InputIterator>
+    void appendRange(InputIterator first,
+                     InputIterator last,
+                     std::input_iterator_tag)
+    {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    template <typename ForwardIterator>
+    void appendRange(ForwardIterator first,
+                     ForwardIterator last,
+                     std::forward_iterator_tag)
+    {
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        if (_size + count > _capacity) {
+            reallocate(std::max(_size + count, 2 * _capacity));
+        }
+        for (; first != last; ++first) {
+            new (_data + _size) T(*first);
+            ++_size;
+        }
+    }
+
+    void reallocate(size_t capacity)
+    {
+        moveTo(allocate(capacity), capacity);
+    }
+
+    // Moves the elements to `data`, which takes over from the current
+    // storage.
+    void moveTo(T* data, size_t capacity)
+    {
+        for (size_t i = 0; i < _size; ++i) {
+            new (data + i) T(std::move_if_noexcept(_data[i]));
+        }
+        destroy(begin(), end());
+        deallocate();
+        _data = data;
+        _capacity = capacity;
+    }
+
+    // Leaves `other` empty. Expects this vector to be empty.
+    void moveFrom(SmallVector& other)
+    {
+        if (!other.isInline()) {
+            deallocate();
+            _data = other._data;
+            _capacity = other._capacity;
+            _size = other._size;
+            other._data = other.inlineData();
+            other._capacity = N;
+            other._size = 0;
+            return;
+        }
+        reserve(other._size);
+        for (auto&& value : other) {
+            new (_data + _size) T(std::move(value));
+            ++_size;
+        }
+        other.clear();
+    }
+
+    T* _data;
+    size_t _size;
+    size_t _capacity;
+    Storage _inline[N];
+};
+
+template <typename T, size_t N>
+constexpr size_t SmallVector<T, N>::kInlineCapacity;
+
+template <typename T, size_t N>
+void swap(SmallVector<T, N>& lhs, SmallVector<T, N>& rhs)
+{
+    lhs.swap(rhs);
+}
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t N>
+bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // JAEGERTRACING_UTILS_SMALLVECTOR_H
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/SmallVector.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jaegertracing {
+namespace utils {
+
+TEST(SmallVector, testGrowsOutOfInlineStorage)
+{
+    SmallVector<std::string, 2> values;
+    ASSERT_TRUE(values.empty());
+    ASSERT_EQ(2, values.capacity());
+    const auto* inlineData = values.data();
+
+    values.push_back("a");
+    values.emplace_back("b");
+    ASSERT_EQ(inlineData, values.data());
+
+    // Growing while the new element refers to an existing one.
+    values.push_back(values.front());
+    ASSERT_NE(inlineData, values.data());
+    ASSERT_EQ(3, values.size());
+    ASSERT_GE(values.capacity(), 3);
+    ASSERT_EQ((std::vector<std::string>{ "a", "b", "a" }),
+              std::vector<std::string>(values.begin(), values.end()));
+
+    values.pop_back();
+    ASSERT_EQ("b", values.back());
+    values.clear();
+    ASSERT_TRUE(values.empty());
+}
+
+TEST(SmallVector, testMoveAndCopy)
+{
+    SmallVector<std::unique_ptr<int>, 2> small;
+    small.emplace_back(new int(1));
+    SmallVector<std::unique_ptr<int>, 2> large;
+    for (auto i = 0; i < 3; ++i) {
+        large.emplace_back(new int(i));
+    }
+    const auto* largeData = large.data();
+
+    auto movedSmall(std::move(small));
+    ASSERT_TRUE(small.empty());
+    ASSERT_EQ(1, *movedSmall[0]);
+
+    // Heap storage is taken over rather than moved element by element.
+    auto movedLarge(std::move(large));
+    ASSERT_TRUE(large.empty());
+    ASSERT_EQ(2, large.capacity());
+    ASSERT_EQ(largeData, movedLarge.data());
+
+    swap(movedSmall, movedLarge);
+    ASSERT_EQ(3, movedSmall.size());
+    ASSERT_EQ(1, movedLarge.size());
+    ASSERT_EQ(1, *movedLarge[0]);
+
+    const SmallVector<std::string, 2> strings{ "a", "b", "c" };
+    SmallVector<std::string, 2> copy;
+    copy = strings;
+    ASSERT_EQ(strings, copy);
+    copy.assign(strings.begin(), strings.begin() + 1);
+    ASSERT_EQ(1, copy.size());
+    ASSERT_NE(strings, copy);
+}
+
+TEST(SmallVector, testInsert)
+{
+    SmallVector<int, 4> values{ 1, 4 };
+    const std::vector<int> middle{ 2, 3 };
+    values.insert(values.begin() + 1, middle.begin(), middle.end());
+    values.insert(values.end(), middle.begin(), middle.end());
+    ASSERT_EQ((std::vector<int>{ 1, 2, 3, 4, 2, 3 }),
+              std::vector<int>(values.begin(), values.end()));
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
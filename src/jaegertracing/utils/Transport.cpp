@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/utils/Transport.h"
+
+#include <thrift/protocol/TProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+namespace jaegertracing {
+namespace utils {
+
+namespace {
+
+// OBSERVE only reads the bytes, the cast is never written through.
+std::shared_ptr<apache::thrift::transport::TMemoryBuffer>
+observe(const std::string& bytes)
+{
+    using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+    return std::shared_ptr<TMemoryBuffer>(new TMemoryBuffer(
+        reinterpret_cast<uint8_t*>(const_cast<char*>(bytes.data())),
+        static_cast<uint32_t>(bytes.size()),
+        TMemoryBuffer::OBSERVE));
+}
+
+void write(apache::thrift::protocol::TProtocol& protocol,
+           const std::string& bytes)
+{
+    protocol.getTransport()->write(
+        reinterpret_cast<const uint8_t*>(bytes.data()),
+        static_cast<uint32_t>(bytes.size()));
+}
+
+}  // anonymous namespace
+
+void Transport::emitSerializedBatch(const std::string& process,
+                                    const std::string& spans,
+                                    int numSpans)
+{
+    thrift::Batch batch;
+    batch.process.read(protocolFactory()->getProtocol(observe(process)).get());
+    auto protocol = protocolFactory()->getProtocol(observe(spans));
+    batch.spans.resize(numSpans);
+    for (auto&& span : batch.spans) {
+        span.read(protocol.get());
+    }
+    emitBatch(batch);
+}
+
+void Transport::emitSerializedBatches(
+    const std::vector<SerializedBatch>& batches, size_t& numSent)
+{
+    numSent = 0;
+    for (auto&& batch : batches) {
+        emitSerializedBatch(*batch._process, *batch._spans, batch._numSpans);
+        ++numSent;
+    }
+}
+
+void Transport::writeSerializedBatch(
+    apache::thrift::protocol::TProtocol& protocol,
+    const std::string& process,
+    const std::string& spans,
+    int numSpans)
+{
+    using apache::thrift::protocol::T_LIST;
+    using apache::thrift::protocol::T_STRUCT;
+
+    // Mirrors thrift::Batch::write(). Both protocols encode a nested struct
+    // independently of what precedes it, so encoded structs can be copied
+    // straight into the underlying transport.
+    protocol.writeStructBegin("Batch");
+
+    protocol.writeFieldBegin("process", T_STRUCT, 1);
+    write(protocol, process);
+    protocol.writeFieldEnd();
+
+    protocol.writeFieldBegin("spans", T_LIST, 2);
+    protocol.writeListBegin(T_STRUCT, static_cast<uint32_t>(numSpans));
+    write(protocol, spans);
+    protocol.writeListEnd();
+    protocol.writeFieldEnd();
+
+    protocol.writeFieldStop();
+    protocol.writeStructEnd();
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
@@ -17,6 +17,9 @@
 #ifndef JAEGERTRACING_UTILS_SENDER_H
 #define JAEGERTRACING_UTILS_SENDER_H
 
+#include <string>
+#include <vector>
+
 #include "jaegertracing/net/Socket.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
 
@@ -25,6 +28,13 @@ namespace utils {
 
 class Transport {
   public:
+    // An encoded batch as passed to emitSerializedBatch().
+    struct SerializedBatch {
+        const std::string* _process;
+        const std::string* _spans;
+        int _numSpans;
+    };
+
     Transport(int maxPacketSize)
         : _maxPacketSize(maxPacketSize)
     {
@@ -34,9 +44,51 @@ class Transport {
 
     virtual void emitBatch(const thrift::Batch& batch) = 0;
 
+    // Sends a batch of an encoded process and `numSpans` spans, encoded
+    // back to back in `spans`, both with a protocol from protocolFactory().
+    // The default decodes them again and calls emitBatch(); transporters
+    // override it to copy the encoded bytes into the message as they are.
+    virtual void emitSerializedBatch(const std::string& process,
+                                     const std::string& spans,
+                                     int numSpans);
+
+    // Sends `batches` in order. If one of them fails, throws once
+    // `numSent` holds the number of batches sent before it. The default
+    // calls emitSerializedBatch() for each batch; transporters that can
+    // send several messages with one call override it.
+    virtual void
+    emitSerializedBatches(const std::vector<SerializedBatch>& batches,
+                          size_t& numSent);
+
+    // Number of batches worth passing to one emitSerializedBatches() call.
+    // Senders may hold back full batches until they have that many.
+    virtual int maxBatchesPerSend() const { return 1; }
+
+    // Writes the same bytes as thrift::Batch::write() for a batch of the
+    // decoded `process` and `spans`.
+    static void
+    writeSerializedBatch(apache::thrift::protocol::TProtocol& protocol,
+                         const std::string& process,
+                         const std::string& spans,
+                         int numSpans);
+
+    // Whether emitted batches complete after the emit call returns. Such
+    // transporters count sent and failed spans in the reporter metrics
+    // themselves.
+    virtual bool asynchronous() const { return false; }
+
+    // Whether emitted batches are written out while they are encoded,
+    // rather than encoded to memory first.
+    virtual bool streamsBatches() const { return false; }
+
     int maxPacketSize() const { return _maxPacketSize; }
 
-    void close() { _socket.close(); }
+    // Size senders should keep their messages to, up to maxPacketSize().
+    // Transporters that find out about a lower limit from failed sends
+    // return less.
+    virtual int targetPacketSize() const { return _maxPacketSize; }
+
+    virtual void close() { _socket.close(); }
 
     virtual std::unique_ptr<apache::thrift::protocol::TProtocolFactory>
     protocolFactory() const = 0;
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jaegertracing/utils/Transport.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+using TMemoryBuffer = apache::thrift::transport::TMemoryBuffer;
+using TProtocolFactory = apache::thrift::protocol::TProtocolFactory;
+
+template <typename ThriftType>
+std::string encode(TProtocolFactory& protocolFactory, const ThriftType& value)
+{
+    std::shared_ptr<TMemoryBuffer> buffer(new TMemoryBuffer());
+    auto protocol = protocolFactory.getProtocol(buffer);
+    value.write(protocol.get());
+    return buffer->getBufferAsString();
+}
+
+thrift::Batch makeBatch()
+{
+    thrift::Batch batch;
+    batch.process.__set_serviceName("test-service");
+    thrift::Tag processTag;
+    processTag.__set_key("hostname");
+    processTag.__set_vType(thrift::TagType::STRING);
+    processTag.__set_vStr("localhost");
+    batch.process.__set_tags({ processTag });
+
+    for (auto i = 0; i < 3; ++i) {
+        thrift::Span span;
+        span.__set_traceIdLow(i + 1);
+        span.__set_spanId(i + 10);
+        span.__set_operationName("span-" + std::to_string(i));
+        span.__set_startTime(1000 * i);
+        span.__set_duration(10);
+        thrift::Tag tag;
+        tag.__set_key("index");
+        tag.__set_vType(thrift::TagType::LONG);
+        tag.__set_vLong(i);
+        span.__set_tags({ tag });
+        batch.spans.push_back(span);
+    }
+    return batch;
+}
+
+void testWriteSerializedBatch(TProtocolFactory& protocolFactory)
+{
+    const auto batch = makeBatch();
+    std::string spans;
+    for (auto&& span : batch.spans) {
+        spans += encode(protocolFactory, span);
+    }
+
+    std::shared_ptr<TMemoryBuffer> buffer(new TMemoryBuffer());
+    auto protocol = protocolFactory.getProtocol(buffer);
+    Transport::writeSerializedBatch(*protocol,
+                                    encode(protocolFactory, batch.process),
+                                    spans,
+                                    static_cast<int>(batch.spans.size()));
+    ASSERT_EQ(encode(protocolFactory, batch), buffer->getBufferAsString());
+}
+
+}  // anonymous namespace
+
+TEST(Transport, testWriteSerializedBatchCompact)
+{
+    apache::thrift::protocol::TCompactProtocolFactory protocolFactory;
+    testWriteSerializedBatch(protocolFactory);
+}
+
+TEST(Transport, testWriteSerializedBatchBinary)
+{
+    apache::thrift::protocol::TBinaryProtocolFactory protocolFactory;
+    testWriteSerializedBatch(protocolFactory);
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
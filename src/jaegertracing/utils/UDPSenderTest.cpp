@@ -14,15 +14,20 @@
  * limitations under the License.
  */
 
+#include "jaegertracing/metrics/InMemoryStatsReporter.h"
 #include "jaegertracing/net/IPAddress.h"
 #include "jaegertracing/net/Socket.h"
+#include "jaegertracing/testutils/MockAgent.h"
 #include "jaegertracing/thrift-gen/jaeger_types.h"
 #include "jaegertracing/thrift-gen/zipkincore_types.h"
 #include "jaegertracing/utils/UDPTransporter.h"
+#include <chrono>
 #include <future>
 #include <gtest/gtest.h>
 #include <stdexcept>
 #include <thread>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
 #include <vector>
 
 namespace jaegertracing {
@@ -79,5 +84,107 @@ TEST(UDPSender, testBigMessage)
     serverThread.join();
 }
 
+TEST(UDPSender, testTargetPacketSize)
+{
+    net::Socket socket;
+    socket.open(AF_INET, SOCK_DGRAM);
+    socket.bind(net::IPAddress::v4("127.0.0.1", 0));
+    ::sockaddr_storage addrStorage;
+    ::socklen_t addrLen = sizeof(addrStorage);
+    const auto returnCode = ::getsockname(
+        socket.handle(), reinterpret_cast<::sockaddr*>(&addrStorage), &addrLen);
+    ASSERT_EQ(0, returnCode);
+    const net::IPAddress serverAddr(addrStorage, addrLen);
+
+    metrics::InMemoryStatsReporter stats;
+    auto metrics = metrics::Metrics::fromStatsReporter(stats);
+    // More than a UDP datagram can carry, so that the kernel rejects large
+    // packets with EMSGSIZE.
+    constexpr auto kMaxPacketSize = 80000;
+    UDPTransporter udpClient(
+        serverAddr, kMaxPacketSize, 1, IOBackend::kSockets, metrics.get());
+    ASSERT_EQ(kMaxPacketSize, udpClient.targetPacketSize());
+    ASSERT_EQ(kMaxPacketSize, stats.gauges().at("jaeger.reporter-packet-size"));
+
+    const std::string process;
+    ASSERT_THROW(
+        udpClient.emitSerializedBatch(process, std::string(70000, 'x'), 1),
+        std::system_error);
+    ASSERT_EQ(kMaxPacketSize / 2, udpClient.targetPacketSize());
+    ASSERT_EQ(kMaxPacketSize / 2,
+              stats.gauges().at("jaeger.reporter-packet-size"));
+
+    // Grows again once packets go out.
+    const std::string spans(100, 'x');
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT_NO_THROW(udpClient.emitSerializedBatch(process, spans, 1));
+    }
+    ASSERT_EQ(kMaxPacketSize / 2 + kMaxPacketSize / 8,
+              udpClient.targetPacketSize());
+}
+
+namespace {
+
+void testSendPackets(IOBackend ioBackend)
+{
+    auto mockAgent = testutils::MockAgent::make();
+    mockAgent->start();
+
+    apache::thrift::protocol::TCompactProtocolFactory protocolFactory;
+    std::shared_ptr<apache::thrift::transport::TMemoryBuffer> buffer(
+        new apache::thrift::transport::TMemoryBuffer());
+    auto protocol = protocolFactory.getProtocol(buffer);
+    thrift::Process process;
+    process.__set_serviceName("test-service");
+    process.write(protocol.get());
+    const auto processBytes = buffer->getBufferAsString();
+    buffer->resetBuffer();
+    thrift::Span span;
+    span.__set_operationName("test");
+    span.write(protocol.get());
+    const auto spanBytes = buffer->getBufferAsString();
+
+    // More batches than fit in one call.
+    constexpr auto kNumBatches = 5;
+    std::vector<Transport::SerializedBatch> batches(kNumBatches);
+    for (auto&& batch : batches) {
+        batch._process = &processBytes;
+        batch._spans = &spanBytes;
+        batch._numSpans = 1;
+    }
+
+    UDPTransporter udpClient(
+        mockAgent->spanServerAddress(), 0, 2, ioBackend);
+    ASSERT_EQ(2, udpClient.maxBatchesPerSend());
+    size_t numSent = 0;
+    udpClient.emitSerializedBatches(batches, numSent);
+    ASSERT_EQ(kNumBatches, static_cast<int>(numSent));
+
+    for (auto i = 0; i < 100 && mockAgent->batches().size() < kNumBatches;
+         ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto received = mockAgent->batches();
+    ASSERT_EQ(kNumBatches, static_cast<int>(received.size()));
+    for (auto&& batch : received) {
+        ASSERT_EQ("test-service", batch.process.serviceName);
+        ASSERT_EQ(1, static_cast<int>(batch.spans.size()));
+        ASSERT_EQ("test", batch.spans[0].operationName);
+    }
+}
+
+}  // anonymous namespace
+
+TEST(UDPSender, testSendPackets)
+{
+    testSendPackets(IOBackend::kSockets);
+}
+
+TEST(UDPSender, testSendPacketsIOUring)
+{
+    // Also passes, on sockets, where io_uring is not available.
+    testSendPackets(IOBackend::kIOUring);
+}
+
 }  // namespace utils
 }  // namespace jaegertracing
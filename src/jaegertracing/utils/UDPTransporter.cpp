@@ -15,29 +15,334 @@
  */
 
 #include "jaegertracing/utils/UDPTransporter.h"
+#include <algorithm>
 #include <thrift/protocol/TCompactProtocol.h>
 #include <thrift/protocol/TProtocol.h>
 
+#ifdef __linux__
+#include <sys/uio.h>
+#endif
+
 namespace jaegertracing {
 namespace utils {
+namespace {
+
+#ifdef MSG_NOSIGNAL
+// An agent closing a connected Unix socket must not raise SIGPIPE.
+constexpr auto kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr auto kSendFlags = 0;
+#endif
+
+// Bounds of the adaptive target packet size. Below 1KB, the process alone
+// may not leave room for spans.
+constexpr auto kMinTargetPacketSize = 1024;
+constexpr size_t kPacketSizeGrowthInterval = 100;
+
+}  // anonymous namespace
 
-UDPTransporter::UDPTransporter(const net::IPAddress& serverAddr, int maxPacketSize)
-    : Transport(maxPacketSize == 0 ? kUDPPacketMaxLength
-                                   : maxPacketSize)
+UDPTransporter::UDPTransporter(const net::IPAddress& serverAddr,
+                               int maxPacketSize,
+                               int packetsPerSend,
+                               IOBackend ioBackend,
+                               metrics::Metrics* metrics)
+    : UDPTransporter(maxPacketSize == 0 ? kUDPPacketMaxLength
+                                        : maxPacketSize,
+                     packetsPerSend,
+                     ioBackend,
+                     metrics)
+{
+    _serverAddr = serverAddr;
+    _socket.open(AF_INET, SOCK_DGRAM);
+    _socket.connect(_serverAddr);
+}
+
+UDPTransporter::UDPTransporter(int maxPacketSize,
+                               int packetsPerSend,
+                               IOBackend ioBackend,
+                               metrics::Metrics* metrics)
+    : Transport(maxPacketSize)
     , _buffer(new apache::thrift::transport::TMemoryBuffer(_maxPacketSize))
-    , _serverAddr(serverAddr)
+    , _serverAddr()
+    , _protocol()
     , _client()
+    , _packetsPerSend(packetsPerSend > 1 ? packetsPerSend : 1)
+    , _packets()
+#ifdef __linux__
+    , _useSendmmsg(true)
+#else
+    , _useSendmmsg(false)
+#endif
+#ifdef __linux__
+    , _ring()
+#endif
+    , _targetPacketSize(0)
+    , _numSentAtTarget(0)
+    , _metrics(metrics)
 {
     using TProtocolFactory = apache::thrift::protocol::TProtocolFactory;
     using TCompactProtocolFactory =
         apache::thrift::protocol::TCompactProtocolFactory;
 
-    _socket.open(AF_INET, SOCK_DGRAM);
-    _socket.connect(_serverAddr);
     std::shared_ptr<TProtocolFactory> protocolFactory(
         new TCompactProtocolFactory());
-    auto protocol = protocolFactory->getProtocol(_buffer);
-    _client.reset(new agent::thrift::AgentClient(protocol));
+    _protocol = protocolFactory->getProtocol(_buffer);
+    _client.reset(new agent::thrift::AgentClient(_protocol));
+
+#ifdef __linux__
+    // Single packets gain nothing from a ring.
+    if (ioBackend == IOBackend::kIOUring && _packetsPerSend > 1 &&
+        IOUring::available()) {
+        try {
+            _ring.reset(new IOUring(_packetsPerSend));
+        } catch (const std::system_error&) {
+            // Out of locked memory for the ring, use sendmmsg().
+        }
+    }
+#else
+    (void)ioBackend;
+#endif
+
+    setTargetPacketSize(_maxPacketSize);
+}
+
+void UDPTransporter::emitSerializedBatch(const std::string& process,
+                                         const std::string& spans,
+                                         int numSpans)
+{
+    writeMessage(process, spans, numSpans);
+    sendBuffer(numSpans);
+}
+
+void UDPTransporter::emitSerializedBatches(
+    const std::vector<SerializedBatch>& batches, size_t& numSent)
+{
+    numSent = 0;
+    if (_packetsPerSend == 1 || batches.size() == 1) {
+        Transport::emitSerializedBatches(batches, numSent);
+        return;
+    }
+
+    for (auto begin = batches.begin(); begin != batches.end();) {
+        const auto end =
+            begin + std::min<size_t>(_packetsPerSend, batches.end() - begin);
+        _packets.resize(end - begin);
+        auto packet = _packets.begin();
+        for (auto batch = begin; batch != end; ++batch, ++packet) {
+            writeMessage(*batch->_process, *batch->_spans, batch->_numSpans);
+            uint8_t* data = nullptr;
+            uint32_t size = 0;
+            getPacket(batch->_numSpans, data, size);
+            packet->assign(reinterpret_cast<const char*>(data), size);
+        }
+        size_t numPacketsSent = 0;
+        try {
+            sendPackets(numPacketsSent);
+        } catch (...) {
+            numSent += numPacketsSent;
+            throw;
+        }
+        numSent += numPacketsSent;
+        begin = end;
+    }
+}
+
+void UDPTransporter::writeMessage(const std::string& process,
+                                  const std::string& spans,
+                                  int numSpans)
+{
+    using apache::thrift::protocol::T_ONEWAY;
+    using apache::thrift::protocol::T_STRUCT;
+
+    // Same message as AgentClient::emitBatch().
+    _buffer->resetBuffer();
+    _protocol->writeMessageBegin("emitBatch", T_ONEWAY, 0);
+    _protocol->writeStructBegin("Agent_emitBatch_pargs");
+    _protocol->writeFieldBegin("batch", T_STRUCT, 1);
+    writeSerializedBatch(*_protocol, process, spans, numSpans);
+    _protocol->writeFieldEnd();
+    _protocol->writeFieldStop();
+    _protocol->writeStructEnd();
+    _protocol->writeMessageEnd();
+    _protocol->getTransport()->writeEnd();
+    _protocol->getTransport()->flush();
+}
+
+void UDPTransporter::sendBuffer(size_t numSpans)
+{
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    getPacket(numSpans, data, size);
+    sendPacket(reinterpret_cast<char*>(data), sizeof(uint8_t) * size);
+}
+
+void UDPTransporter::getPacket(size_t numSpans, uint8_t*& data, uint32_t& size)
+{
+    _buffer->getBuffer(&data, &size);
+    if (static_cast<int>(size) > _maxPacketSize) {
+        std::ostringstream oss;
+        oss << "Data does not fit within one packet"
+               ", size "
+            << size << ", max " << _maxPacketSize << ", spans " << numSpans;
+        throw std::logic_error(oss.str());
+    }
+}
+
+void UDPTransporter::sendPacket(const char* data, size_t size)
+{
+    const auto numWritten = ::send(_socket.handle(), data, size, kSendFlags);
+    if (static_cast<size_t>(numWritten) != size) {
+        const auto error = errno;
+        onSendError(error);
+        std::ostringstream oss;
+        oss << "Failed to write message"
+               ", numWritten="
+            << numWritten << ", size=" << size;
+        throw std::system_error(error, std::system_category(), oss.str());
+    }
+    onPacketsSent(1);
+}
+
+void UDPTransporter::sendPackets(size_t& numSent)
+{
+    numSent = 0;
+#ifdef __linux__
+    if (_ring && submitPackets(numSent)) {
+        onPacketsSent(numSent);
+        return;
+    }
+    if (_useSendmmsg) {
+        std::vector<::iovec> iovecs(_packets.size());
+        std::vector<::mmsghdr> messages(_packets.size());
+        for (size_t i = 0; i < _packets.size(); ++i) {
+            iovecs[i].iov_base = const_cast<char*>(_packets[i].data());
+            iovecs[i].iov_len = _packets[i].size();
+            messages[i] = ::mmsghdr();
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        while (numSent < messages.size()) {
+            // Returns how many datagrams went out before an error, if any;
+            // the error itself is reported by the next call.
+            const auto result = ::sendmmsg(_socket.handle(),
+                                           &messages[numSent],
+                                           messages.size() - numSent,
+                                           kSendFlags);
+            if (result >= 0) {
+                numSent += result;
+            }
+            else if (errno == ENOSYS && numSent == 0) {
+                // Kernel without sendmmsg(), use send() from now on.
+                _useSendmmsg = false;
+                break;
+            }
+            else if (errno != EINTR) {
+                const auto error = errno;
+                onPacketsSent(numSent);
+                onSendError(error);
+                std::ostringstream oss;
+                oss << "Failed to write messages"
+                       ", sent="
+                    << numSent << ", total=" << messages.size();
+                throw std::system_error(
+                    error, std::system_category(), oss.str());
+            }
+        }
+        if (_useSendmmsg) {
+            onPacketsSent(numSent);
+            return;
+        }
+    }
+#endif
+    for (; numSent < _packets.size(); ++numSent) {
+        sendPacket(_packets[numSent].data(), _packets[numSent].size());
+    }
+}
+
+#ifdef __linux__
+bool UDPTransporter::submitPackets(size_t& numSent)
+{
+    std::vector<::iovec> iovecs(_packets.size());
+    std::vector<::msghdr> messages(_packets.size());
+    std::vector<int> results;
+    while (numSent < _packets.size()) {
+        // Each send is linked to the next one, so that packets go out in
+        // order and none follows a failed one.
+        const auto begin = numSent;
+        const auto end = std::min<size_t>(begin + _ring->capacity(),
+                                          _packets.size());
+        for (auto i = begin; i < end; ++i) {
+            iovecs[i].iov_base = const_cast<char*>(_packets[i].data());
+            iovecs[i].iov_len = _packets[i].size();
+            messages[i] = ::msghdr();
+            messages[i].msg_iov = &iovecs[i];
+            messages[i].msg_iovlen = 1;
+            _ring->queueSendmsg(
+                _socket.handle(), &messages[i], kSendFlags, i + 1 < end, i);
+        }
+        _ring->submit(end - begin);
+
+        results.assign(end - begin, 0);
+        uint64_t index = 0;
+        auto completed = 0;
+        while (_ring->complete(index, completed)) {
+            results[index - begin] = completed;
+        }
+        for (auto&& result : results) {
+            if (result >= 0) {
+                ++numSent;
+            }
+            else if ((result == -EINVAL || result == -EOPNOTSUPP) &&
+                     numSent == 0) {
+                // Kernel without sends through io_uring, use sendmmsg()
+                // from now on.
+                _ring.reset();
+                return false;
+            }
+            else {
+                onPacketsSent(numSent);
+                onSendError(-result);
+                std::ostringstream oss;
+                oss << "Failed to write messages"
+                       ", sent="
+                    << numSent << ", total=" << _packets.size();
+                throw std::system_error(
+                    -result, std::system_category(), oss.str());
+            }
+        }
+    }
+    return true;
+}
+#endif
+
+void UDPTransporter::onSendError(int error)
+{
+    if (error == EMSGSIZE || error == ENOBUFS) {
+        setTargetPacketSize(std::max(
+            _targetPacketSize / 2,
+            std::min(kMinTargetPacketSize, _maxPacketSize)));
+    }
+}
+
+void UDPTransporter::onPacketsSent(size_t numPackets)
+{
+    if (_targetPacketSize == _maxPacketSize) {
+        return;
+    }
+    _numSentAtTarget += numPackets;
+    if (_numSentAtTarget >= kPacketSizeGrowthInterval) {
+        setTargetPacketSize(std::min(
+            _targetPacketSize + _targetPacketSize / 4, _maxPacketSize));
+    }
+}
+
+void UDPTransporter::setTargetPacketSize(int size)
+{
+    _targetPacketSize = size;
+    _numSentAtTarget = 0;
+    if (_metrics) {
+        _metrics->reporterPacketSize().update(size);
+    }
 }
 
 }  // namespace utils
@@ -21,14 +21,17 @@
 #include <sstream>
 #include <stdexcept>
 #include <system_error>
+#include <vector>
 
 #include "jaegertracing/Compilers.h"
 
 #include <thrift/protocol/TCompactProtocol.h>
 #include <thrift/transport/TBufferTransports.h>
 
+#include "jaegertracing/utils/IOUring.h"
 #include "jaegertracing/utils/Transport.h"
 
+#include "jaegertracing/metrics/Metrics.h"
 #include "jaegertracing/net/IPAddress.h"
 #include "jaegertracing/thrift-gen/Agent.h"
 
@@ -39,7 +42,17 @@ class UDPTransporter : public Transport {
   public:
     static constexpr auto kUDPPacketMaxLength = 65000;
 
-    UDPTransporter(const net::IPAddress& serverAddr, int maxPacketSize);
+    // With `packetsPerSend` above 1, emitSerializedBatches() sends up to
+    // that many packets with a single sendmmsg() call where available, or
+    // as linked sends submitted to an io_uring with IOBackend::kIOUring.
+    // Falls back to sockets where io_uring is not available. The target
+    // packet size is reported to the jaeger.reporter-packet-size gauge of
+    // `metrics`, if given.
+    UDPTransporter(const net::IPAddress& serverAddr,
+                   int maxPacketSize,
+                   int packetsPerSend = 1,
+                   IOBackend ioBackend = IOBackend::kSockets,
+                   metrics::Metrics* metrics = nullptr);
 
     void emitZipkinBatch(
         const std::vector<twitter::zipkin::thrift::Span>& spans)
@@ -51,35 +64,79 @@ class UDPTransporter : public Transport {
     {
         _buffer->resetBuffer();
         _client->emitBatch(batch);
-        uint8_t* data = nullptr;
-        uint32_t size = 0;
-        _buffer->getBuffer(&data, &size);
-        if (static_cast<int>(size) > _maxPacketSize) {
-            std::ostringstream oss;
-            oss << "Data does not fit within one UDP packet"
-                   ", size "
-                << size << ", max " << _maxPacketSize << ", spans "
-                << batch.spans.size();
-            throw std::logic_error(oss.str());
-        }
-        const auto numWritten = ::send(_socket.handle(), reinterpret_cast<char*>(data), sizeof(uint8_t) * size, 0);
-        if (static_cast<unsigned>(numWritten) != size) {
-            std::ostringstream oss;
-            oss << "Failed to write message"
-                   ", numWritten="
-                << numWritten << ", size=" << size;
-            throw std::system_error(errno, std::system_category(), oss.str());
-        }
+        sendBuffer(batch.spans.size());
     }
 
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override;
+
+    void emitSerializedBatches(const std::vector<SerializedBatch>& batches,
+                               size_t& numSent) override;
+
+    int maxBatchesPerSend() const override { return _packetsPerSend; }
+
+    // Starts at maxPacketSize(). Halves, down to 1KB, each time a send
+    // fails with EMSGSIZE or ENOBUFS, as when the path MTU or the socket
+    // buffers turn out to be smaller than the packets, and grows by a
+    // quarter again after each run of 100 packets sent without such errors.
+    int targetPacketSize() const override { return _targetPacketSize; }
+
   std::unique_ptr< apache::thrift::protocol::TProtocolFactory > protocolFactory() const override {
     return std::unique_ptr<apache::thrift::protocol::TProtocolFactory>(new apache::thrift::protocol::TCompactProtocolFactory());
   }
 
+  protected:
+    // Leaves opening and connecting _socket to the subclass, for agents
+    // reached over other kinds of datagram sockets.
+    UDPTransporter(int maxPacketSize,
+                   int packetsPerSend,
+                   IOBackend ioBackend,
+                   metrics::Metrics* metrics);
+
   private:
+    void writeMessage(const std::string& process,
+                      const std::string& spans,
+                      int numSpans);
+
+    void sendBuffer(size_t numSpans);
+
+    // Points `data` at the message in _buffer, which must fit in a packet.
+    void getPacket(size_t numSpans, uint8_t*& data, uint32_t& size);
+
+    void sendPacket(const char* data, size_t size);
+
+    // Sends _packets, counting each one sent in `numSent`.
+    void sendPackets(size_t& numSent);
+
+#ifdef __linux__
+    // Sends _packets through _ring. Returns false, having sent nothing, if
+    // the kernel turns out not to support it.
+    bool submitPackets(size_t& numSent);
+#endif
+
+    // Lower the target packet size after an `error` on send, or raise it
+    // again after packets went out.
+    void onSendError(int error);
+
+    void onPacketsSent(size_t numPackets);
+
+    void setTargetPacketSize(int size);
+
     std::shared_ptr<apache::thrift::transport::TMemoryBuffer> _buffer;
     net::IPAddress _serverAddr;
+    std::shared_ptr<apache::thrift::protocol::TProtocol> _protocol;
     std::unique_ptr<agent::thrift::AgentClient> _client;
+    int _packetsPerSend;
+    std::vector<std::string> _packets;
+    bool _useSendmmsg;
+#ifdef __linux__
+    std::unique_ptr<IOUring> _ring;
+#endif
+    int _targetPacketSize;
+    // Packets sent since the target packet size last changed.
+    size_t _numSentAtTarget;
+    metrics::Metrics* _metrics;
 };
 
 }  // namespace utils
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/UnixTransporter.h"
+
+#ifndef WIN32
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+constexpr auto kUnixScheme = "unix://";
+constexpr auto kUnixPacketScheme = "unixpacket://";
+
+bool startsWith(const std::string& str, const std::string& prefix)
+{
+    return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+}  // anonymous namespace
+
+constexpr int UnixTransporter::kUnixPacketMaxLength;
+
+bool UnixTransporter::parseAddress(const std::string& address,
+                                   std::string& path,
+                                   int& socketType)
+{
+    if (startsWith(address, kUnixScheme)) {
+        path = address.substr(std::strlen(kUnixScheme));
+        socketType = SOCK_DGRAM;
+        return true;
+    }
+    if (startsWith(address, kUnixPacketScheme)) {
+        path = address.substr(std::strlen(kUnixPacketScheme));
+        socketType = SOCK_SEQPACKET;
+        return true;
+    }
+    return false;
+}
+
+UnixTransporter::UnixTransporter(const std::string& path,
+                                 int maxPacketSize,
+                                 int packetsPerSend,
+                                 int socketType,
+                                 IOBackend ioBackend,
+                                 metrics::Metrics* metrics)
+    : UDPTransporter(maxPacketSize == 0 ? kUnixPacketMaxLength
+                                        : maxPacketSize,
+                     packetsPerSend,
+                     ioBackend,
+                     metrics)
+    , _path(path)
+    , _socketType(socketType)
+    , _connected(false)
+{
+    if (_path.empty() || _path.size() >= sizeof(::sockaddr_un().sun_path)) {
+        std::ostringstream oss;
+        oss << "Invalid Unix socket path \"" << _path << '"';
+        throw std::invalid_argument(oss.str());
+    }
+    try {
+        connect();
+    } catch (const std::system_error&) {
+        // The agent may start after us.
+    }
+}
+
+void UnixTransporter::emitBatch(const thrift::Batch& batch)
+{
+    send([this, &batch]() { UDPTransporter::emitBatch(batch); });
+}
+
+void UnixTransporter::emitSerializedBatch(const std::string& process,
+                                          const std::string& spans,
+                                          int numSpans)
+{
+    send([this, &process, &spans, numSpans]() {
+        UDPTransporter::emitSerializedBatch(process, spans, numSpans);
+    });
+}
+
+void UnixTransporter::emitSerializedBatches(
+    const std::vector<SerializedBatch>& batches, size_t& numSent)
+{
+    numSent = 0;
+    send([this, &batches, &numSent]() {
+        UDPTransporter::emitSerializedBatches(batches, numSent);
+    });
+}
+
+void UnixTransporter::close()
+{
+    _connected = false;
+    UDPTransporter::close();
+}
+
+void UnixTransporter::connect()
+{
+    if (_connected) {
+        return;
+    }
+
+    _socket.close();
+    _socket.open(AF_UNIX, _socketType);
+
+    // Datagrams larger than the send buffer fail with EMSGSIZE. The kernel
+    // doubles the value for its bookkeeping and caps it at its maximum.
+    int sendBufferSize = 0;
+    ::socklen_t optionLen = sizeof(sendBufferSize);
+    if (::getsockopt(_socket.handle(),
+                     SOL_SOCKET,
+                     SO_SNDBUF,
+                     &sendBufferSize,
+                     &optionLen) == 0 &&
+        sendBufferSize < 2 * _maxPacketSize) {
+        sendBufferSize = _maxPacketSize;
+        ::setsockopt(_socket.handle(),
+                     SOL_SOCKET,
+                     SO_SNDBUF,
+                     &sendBufferSize,
+                     sizeof(sendBufferSize));
+    }
+
+    ::sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, _path.c_str(), _path.size() + 1);
+    if (::connect(_socket.handle(),
+                  reinterpret_cast<const ::sockaddr*>(&addr),
+                  sizeof(addr)) != 0) {
+        const auto error = errno;
+        _socket.close();
+        std::ostringstream oss;
+        oss << "Cannot connect socket to " << _path;
+        throw std::system_error(error, std::system_category(), oss.str());
+    }
+    _connected = true;
+}
+
+template <typename Function>
+void UnixTransporter::send(Function function)
+{
+    connect();
+    try {
+        function();
+    } catch (const std::system_error&) {
+        close();
+        throw;
+    }
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
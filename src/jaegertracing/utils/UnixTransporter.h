@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef JAEGERTRACING_UTILS_UNIXTRANSPORTER_H
+#define JAEGERTRACING_UTILS_UNIXTRANSPORTER_H
+
+#include <string>
+#include <vector>
+
+#include "jaegertracing/utils/UDPTransporter.h"
+
+#ifndef WIN32
+
+namespace jaegertracing {
+namespace utils {
+
+// Sends the same messages as UDPTransporter to an agent on the same host
+// over an AF_UNIX datagram or seqpacket socket. Skips the IP stack and
+// allows much larger packets. Unlike UDP, sends wait while the agent's
+// receive queue is full, so a stalled agent backs up into the reporter
+// queue, where its overflow policy applies.
+class UnixTransporter : public UDPTransporter {
+  public:
+    static constexpr auto kUnixPacketMaxLength = 256 * 1024;
+
+    // Splits "unix:///path" (SOCK_DGRAM) or "unixpacket:///path"
+    // (SOCK_SEQPACKET) into `path` and `socketType`. Returns false for
+    // other addresses.
+    static bool parseAddress(const std::string& address,
+                             std::string& path,
+                             int& socketType);
+
+    // An agent that is not listening at `path` yet is connected to before
+    // the next send; so is one that went away since.
+    UnixTransporter(const std::string& path,
+                    int maxPacketSize,
+                    int packetsPerSend = 1,
+                    int socketType = SOCK_DGRAM,
+                    IOBackend ioBackend = IOBackend::kSockets,
+                    metrics::Metrics* metrics = nullptr);
+
+    void emitBatch(const thrift::Batch& batch) override;
+
+    void emitSerializedBatch(const std::string& process,
+                             const std::string& spans,
+                             int numSpans) override;
+
+    void emitSerializedBatches(const std::vector<SerializedBatch>& batches,
+                               size_t& numSent) override;
+
+    void close() override;
+
+  private:
+    void connect();
+
+    // Closes the socket on system errors, so the next send reconnects.
+    template <typename Function>
+    void send(Function function);
+
+    std::string _path;
+    int _socketType;
+    bool _connected;
+};
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32
+
+#endif  // JAEGERTRACING_UTILS_UNIXTRANSPORTER_H
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Jaeger Authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "jaegertracing/utils/UnixTransporter.h"
+
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifndef WIN32
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace jaegertracing {
+namespace utils {
+namespace {
+
+class UnixServer {
+  public:
+    UnixServer(const std::string& path, int socketType)
+        : _path(path)
+    {
+        ::unlink(_path.c_str());
+        _socket.open(AF_UNIX, socketType);
+        ::sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, _path.c_str(), sizeof(addr.sun_path) - 1);
+        const auto returnCode =
+            ::bind(_socket.handle(),
+                   reinterpret_cast<const ::sockaddr*>(&addr),
+                   sizeof(addr));
+        EXPECT_EQ(0, returnCode);
+        if (socketType == SOCK_SEQPACKET) {
+            _socket.listen();
+        }
+    }
+
+    ~UnixServer() { ::unlink(_path.c_str()); }
+
+    net::Socket& socket() { return _socket; }
+
+  private:
+    std::string _path;
+    net::Socket _socket;
+};
+
+std::string makePath(const std::string& name)
+{
+    return "/tmp/jaeger-unix-transporter-" + std::to_string(::getpid()) +
+           '-' + name + ".sock";
+}
+
+std::string receive(net::Socket& socket)
+{
+    std::vector<char> buffer(2 * UnixTransporter::kUnixPacketMaxLength);
+    const auto numRead = ::recv(socket.handle(), &buffer[0], buffer.size(), 0);
+    return std::string(&buffer[0], numRead > 0 ? numRead : 0);
+}
+
+}  // anonymous namespace
+
+TEST(UnixTransporter, testParseAddress)
+{
+    std::string path;
+    auto socketType = 0;
+    ASSERT_TRUE(UnixTransporter::parseAddress(
+        "unix:///var/run/jaeger.sock", path, socketType));
+    ASSERT_EQ("/var/run/jaeger.sock", path);
+    ASSERT_EQ(SOCK_DGRAM, socketType);
+    ASSERT_TRUE(UnixTransporter::parseAddress(
+        "unixpacket:///var/run/jaeger.sock", path, socketType));
+    ASSERT_EQ("/var/run/jaeger.sock", path);
+    ASSERT_EQ(SOCK_SEQPACKET, socketType);
+    ASSERT_FALSE(
+        UnixTransporter::parseAddress("127.0.0.1:6831", path, socketType));
+
+    ASSERT_THROW(UnixTransporter("", 0), std::invalid_argument);
+    ASSERT_THROW(UnixTransporter(std::string(200, 'x'), 0),
+                 std::invalid_argument);
+}
+
+TEST(UnixTransporter, testSeqpacket)
+{
+    const auto path = makePath("seqpacket");
+    UnixServer server(path, SOCK_SEQPACKET);
+    UnixTransporter transporter(path, 0, 1, SOCK_SEQPACKET);
+    auto connection = server.socket().accept();
+
+    // Bigger than any UDP packet.
+    const std::string process("process");
+    const std::string spans(
+        2 * UDPTransporter::kUDPPacketMaxLength, 's');
+    transporter.emitSerializedBatch(process, spans, 1);
+
+    const auto packet = receive(connection);
+    ASSERT_GT(packet.size(), spans.size());
+    ASSERT_NE(std::string::npos, packet.find(spans));
+}
+
+TEST(UnixTransporter, testConnectLater)
+{
+    const auto path = makePath("later");
+    ::unlink(path.c_str());
+    UnixTransporter transporter(path, 0);
+
+    const std::string process("process");
+    const std::string spans("spans");
+    ASSERT_THROW(transporter.emitSerializedBatch(process, spans, 1),
+                 std::system_error);
+
+    UnixServer server(path, SOCK_DGRAM);
+    transporter.emitSerializedBatch(process, spans, 1);
+    ASSERT_NE(std::string::npos, receive(server.socket()).find(spans));
+}
+
+}  // namespace utils
+}  // namespace jaegertracing
+
+#endif  // WIN32